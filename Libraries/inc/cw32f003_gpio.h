@@ -577,6 +577,70 @@ typedef enum
 #define PC04_AFx_GTIMCH4()           (CW_GPIOC->AFRL_f.AFR4 = 5)
 #define PC04_AFx_GTIMTOGN()          (CW_GPIOC->AFRL_f.AFR4 = 6)
 
+//============================================================
+// FAST PIN ACCESS
+// One store to the port's BSRR/BRR/TOG register: atomic (no read-modify-write), so
+// usable from ISRs and the main loop alike. Forced inline, so with a constant port and
+// GPIO_PIN_x mask an edge is a single STR even at -O0 (plain inline is ignored there).
+// GPIO_WritePin()/GPIO_TogglePin() remain for pins chosen at run time.
+#if defined(__CC_ARM)
+#define GPIO_FORCE_INLINE            static __forceinline
+#elif defined(__ICCARM__)
+#define GPIO_FORCE_INLINE            _Pragma("inline=forced") static inline
+#else
+#define GPIO_FORCE_INLINE            static inline __attribute__((always_inline))
+#endif
+
+/**
+ * @brief Drives pins high.
+ * @param GPIOx CW_GPIOA, CW_GPIOB or CW_GPIOC
+ * @param GPIO_Pins GPIO_PIN_0/1/2.../7/All, may be combined
+ */
+GPIO_FORCE_INLINE void GPIO_FastSet(GPIO_TypeDef *GPIOx, uint32_t GPIO_Pins)
+{
+    GPIOx->BSRR = GPIO_Pins;
+}
+
+/**
+ * @brief Drives pins low.
+ */
+GPIO_FORCE_INLINE void GPIO_FastClear(GPIO_TypeDef *GPIOx, uint32_t GPIO_Pins)
+{
+    GPIOx->BRR = GPIO_Pins;
+}
+
+/**
+ * @brief Inverts pins.
+ */
+GPIO_FORCE_INLINE void GPIO_FastToggle(GPIO_TypeDef *GPIOx, uint32_t GPIO_Pins)
+{
+    GPIOx->TOG = GPIO_Pins;
+}
+
+/**
+ * @brief Drives pins to a level; with a constant PinState the branch folds away.
+ */
+GPIO_FORCE_INLINE void GPIO_FastWrite(GPIO_TypeDef *GPIOx, uint32_t GPIO_Pins, GPIO_PinState PinState)
+{
+    if (PinState == GPIO_Pin_SET)
+    {
+        GPIOx->BSRR = GPIO_Pins;
+    }
+    else
+    {
+        GPIOx->BRR = GPIO_Pins;
+    }
+}
+
+/**
+ * @brief Reads a pin.
+ * @return GPIO_Pin_SET if any of the given pins is high.
+ */
+GPIO_FORCE_INLINE GPIO_PinState GPIO_FastRead(GPIO_TypeDef *GPIOx, uint32_t GPIO_Pins)
+{
+    return (GPIOx->IDR & GPIO_Pins) ? GPIO_Pin_SET : GPIO_Pin_RESET;
+}
+
 /******************************************************************************
  * Global variable definitions (declared in header file with 'extern')
  ******************************************************************************/
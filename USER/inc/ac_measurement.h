@@ -4,6 +4,17 @@
 #include <stdint.h> // Use standard integer types
 #include <stdbool.h> // For bool type
 
+// --- Typedefs ---
+/**
+ * @brief HLW8032 frame assembler counters (monotonic since AC_Measurement_Init).
+ */
+typedef struct {
+    uint32_t frames_ok;       // Checksum-valid frames handed to the main loop
+    uint32_t frames_dropped;  // Valid frames discarded because the previous one was not yet processed
+    uint32_t resyncs;         // Times the assembler lost sync and had to hunt for a header
+    uint32_t checksum_errors; // Complete frames rejected by the checksum
+} AC_FrameStats_t;
+
 // --- Global Variables (declared extern) ---
 extern volatile bool hlw8032_packet_ready; // Flag set by ISR
 
@@ -15,11 +26,24 @@ extern volatile bool hlw8032_packet_ready; // Flag set by ISR
 void AC_Measurement_Init(void);
 
 /**
- * @brief Processes a received HLW8032 packet from the internal buffer.
+ * @brief Processes the HLW8032 frame published by the UART ISR, in place.
  *        Should be called from the main loop when hlw8032_packet_ready is true.
+ *        Clears hlw8032_packet_ready, handing the frame buffer back to the ISR.
  */
 void AC_Process_HLW8032_Packet(void);
 
+/**
+ * @brief Gets a snapshot of the HLW8032 frame assembler counters.
+ * @param stats Pointer to the structure to fill.
+ */
+void AC_GetFrameStats(AC_FrameStats_t *stats);
+
+/**
+ * @brief Discards a partly received HLW8032 frame and hunts for the next header.
+ *        Call after the UART clock was stopped (deep sleep); not counted as a resync.
+ */
+void AC_Measurement_Resync(void);
+
 /**
  * @brief Gets the last calculated RMS current from HLW8032 data.
  * @return float RMS current in Amperes. Returns last known value.
@@ -29,19 +53,102 @@ float AC_GetCurrent(void);
 /**
  * @brief Gets the last calculated RMS voltage from HLW8032 data.
  * @return float RMS voltage in Volts. Returns last known value.
- * @note Actual calculation needs to be implemented in AC_Process_HLW8032_Packet.
  */
 float AC_GetVoltage(void);
 
 /**
  * @brief Gets the last calculated Active Power from HLW8032 data.
  * @return float Active Power in Watts. Returns last known value.
- * @note Actual calculation needs to be implemented in AC_Process_HLW8032_Packet.
  */
 float AC_GetPower(void);
 
 /**
- * @brief Internal function (called by UART ISR) to store a received byte.
+ * @brief Gets the last calculated RMS voltage (integer, no soft-float).
+ * @return RMS voltage in millivolts. Returns last known value.
+ */
+uint32_t AC_GetVoltage_mV(void);
+
+/**
+ * @brief Gets the last calculated RMS current (integer, no soft-float).
+ * @return RMS current in milliamperes. Returns last known value.
+ */
+uint32_t AC_GetCurrent_mA(void);
+
+/**
+ * @brief Gets the last calculated active power (integer, no soft-float).
+ * @return Active power in milliwatts. Returns last known value.
+ */
+uint32_t AC_GetPower_mW(void);
+
+/**
+ * @brief Gets the last calculated apparent power, Vrms * Irms.
+ * @return Apparent power in milli-volt-amperes.
+ */
+uint32_t AC_GetApparentPower_mVA(void);
+
+/**
+ * @brief Gets the last calculated power factor, P / S.
+ * @return Power factor in per-mille (0..1000).
+ */
+uint16_t AC_GetPowerFactor_Permille(void);
+
+/**
+ * @brief Gets the age of the last decoded HLW8032 frame (SysTick time base).
+ * @return Milliseconds since the last frame (since init if none has arrived yet).
+ */
+uint32_t AC_GetDataAge_ms(void);
+
+/**
+ * @brief Checks whether the V/I/P values are fresh enough to act on.
+ * @return true if a frame was decoded within HLW_STALE_TIMEOUT_MS.
+ */
+bool AC_IsDataValid(void);
+
+/**
+ * @brief Checks the HLW8032 link for a timeout (HLW_LINK_TIMEOUT_MS).
+ *        Reports ERROR_HLW_UART_TIMEOUT once per outage.
+ * @return true if the link is alive, false on timeout.
+ */
+bool AC_Measurement_CheckLink(void);
+
+/**
+ * @brief Starts a new charging session: the session energy total restarts from 0.
+ */
+void AC_Energy_StartSession(void);
+
+/**
+ * @brief Gets the energy delivered in the current session (from the HLW8032 PF pulse count).
+ * @return Session energy in milliwatt-hours.
+ */
+uint32_t AC_Energy_GetSession_mWh(void);
+
+/**
+ * @brief Gets the energy delivered in the current session.
+ * @return Session energy in watt-hours (truncated).
+ */
+uint32_t AC_Energy_GetSession_Wh(void);
+
+/**
+ * @brief Gets the lifetime energy total.
+ * @return Lifetime energy in watt-hours (truncated).
+ */
+uint32_t AC_Energy_GetLifetime_Wh(void);
+
+/**
+ * @brief Gets the number of sessions started.
+ * @return Session count (wraps at 65535).
+ */
+uint16_t AC_Energy_GetSessionCount(void);
+
+/**
+ * @brief Restores the persistent energy counters (e.g. from the flash journal).
+ * @param lifetime_wh Lifetime energy in watt-hours.
+ * @param session_count Number of sessions started.
+ */
+void AC_Energy_Restore(uint32_t lifetime_wh, uint16_t session_count);
+
+/**
+ * @brief Internal function (called by UART ISR) to feed a received byte to the frame assembler.
  * @param byte The received byte.
  */
 void AC_Store_HLW8032_Byte(uint8_t byte);
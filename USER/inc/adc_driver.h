@@ -9,6 +9,7 @@ extern "C" {
 #include "base_types.h" // For bool type if needed, or include stdint.h/stdbool.h directly
 #include <stdint.h>    // For uint16_t
 #include <stdbool.h>   // For bool
+#include "adc_filter.h" // For per-slot filter pipelines
 // #include "cw32f003.h"     // Remove - Not needed here
 // #include "cw32f003_adc.h" // Remove - Not needed here, type is uint32_t
 
@@ -17,6 +18,34 @@ extern "C" {
 // Adjust this value based on your actual VDD or external reference voltage
 #define ADC_REFERENCE_VOLTAGE_MV (3300) // Voltage in millivolts
 
+// Returned by ADC_Temperature_Get_cC() before the first reference pass
+#define ADC_TEMPERATURE_INVALID    INT16_MIN
+
+// VDD compensation factors are Q12 fixed point
+#define ADC_VDD_Q12_SHIFT          12
+#define ADC_VDD_Q12_ONE            (1U << ADC_VDD_Q12_SHIFT)
+
+// Background scan engine settings
+#define ADC_SCAN_AVG_SAMPLES       8   // Running-mean depth per slot (must be a power of two)
+#define ADC_SCAN_REF_PASS_INTERVAL 100 // Run the 1.5V reference pass (temp, VDD) every Nth scan
+#define ADC_SCAN_IRQ_PRIORITY      2   // Below SysTick/UART1 (0) and UART2 (1)
+
+// Hardware oversampling (RESULTACC is 24-bit, CNT is 8-bit -> at most 256 conversions)
+#define ADC_OVERSAMPLE_MAX_LOG2    8   // 256 samples -> 16-bit result
+#define ADC_OVERSAMPLE_13BIT       2   // 4 samples
+#define ADC_OVERSAMPLE_14BIT       4   // 16 samples
+
+/* Typedefs ------------------------------------------------------------------*/
+// Result slots maintained by the background scan engine
+typedef enum {
+    ADC_SCAN_SLOT_CP = 0,   // PA01 / CH1, VDD reference, every scan (high plateau in PWM sync mode)
+    ADC_SCAN_SLOT_CP_LOW,   // PA01 / CH1 sampled in the PWM low plateau (PWM sync mode only)
+    ADC_SCAN_SLOT_PP,       // PA04 / CH2, VDD reference, every scan
+    ADC_SCAN_SLOT_TEMP,     // Internal temperature sensor, 1.5V reference pass
+    ADC_SCAN_SLOT_VDD,      // VDD/3, 1.5V reference pass
+    ADC_SCAN_SLOT_COUNT
+} ADC_ScanSlot_t;
+
 /* Function Prototypes -------------------------------------------------------*/
 
 /**
@@ -54,6 +83,177 @@ float ADC_Read_Internal_Temperature(void);
  */
 uint16_t ADC_Read_Channel_Raw(uint32_t channel); // Use uint32_t for channel
 
+/**
+ * @brief Starts the interrupt-driven background scan of CP, PP, temperature and VDD.
+ *        CP/PP are converted on every ADC_Scan_Trigger(); temperature and VDD are
+ *        converted against the 1.5V reference every ADC_SCAN_REF_PASS_INTERVAL scans.
+ * @return true if the engine is running.
+ */
+bool ADC_Scan_Start(void);
+
+/**
+ * @brief Stops the background scan and waits for any running sequence to finish.
+ *        The result cache keeps its last values.
+ */
+void ADC_Scan_Stop(void);
+
+/**
+ * @brief Checks whether the background scan engine is running.
+ * @return true if running.
+ */
+bool ADC_Scan_IsRunning(void);
+
+/**
+ * @brief Starts the next scan sequence if the previous one has completed.
+ *        Called from SysTick_Handler (1ms).
+ */
+void ADC_Scan_Trigger(void);
+
+/**
+ * @brief Gets the latest raw result of a scan slot. Does not touch ADC registers.
+ * @param slot The result slot.
+ * @return Raw 12-bit result, or 0xFFFF if the slot has not been converted yet.
+ */
+uint16_t ADC_Scan_GetRaw(ADC_ScanSlot_t slot);
+
+/**
+ * @brief Gets the mean of the last ADC_SCAN_AVG_SAMPLES results of a scan slot.
+ * @param slot The result slot.
+ * @return Averaged raw 12-bit result, or 0xFFFF if the slot has not been converted yet.
+ */
+uint16_t ADC_Scan_GetAverage(ADC_ScanSlot_t slot);
+
+/**
+ * @brief Gets the number of results stored in a slot since ADC_Scan_Start().
+ *        Lets callers tell a fresh value from a stale one (e.g., CP low plateau at 100% duty).
+ * @param slot The result slot.
+ * @return Sample count (wraps).
+ */
+uint32_t ADC_Scan_GetSampleCount(ADC_ScanSlot_t slot);
+
+/**
+ * @brief Switches the CP/PP scan between SysTick kicks and ATIM (PWM) triggers.
+ *        In sync mode each scan is started by a compare event in the middle of a PWM
+ *        plateau; CP is stored to ADC_SCAN_SLOT_CP (high) or ADC_SCAN_SLOT_CP_LOW (low).
+ *        SysTick only kicks a scan if no trigger arrived for a few ms (PWM stopped).
+ * @param enable true for PWM synchronised sampling.
+ */
+void ADC_Scan_SetPwmSync(bool enable);
+
+/**
+ * @brief Attaches a filter pipeline (median + IIR + hysteresis) to a scan slot.
+ *        Each new result of the slot is fed to the filter from the ADC interrupt.
+ * @param slot The result slot.
+ * @param filter Initialized filter with static storage, or NULL to detach.
+ * @param vdd_compensate true to filter ADC_Vdd_Compensate()d samples (e.g., CP).
+ */
+void ADC_Scan_AttachFilter(ADC_ScanSlot_t slot, ADC_Filter_t *filter, bool vdd_compensate);
+
+/**
+ * @brief Gets the number of completed CP/PP scans since ADC_Scan_Start().
+ *        Can be used to detect whether the cache is still being refreshed.
+ * @return Completed scan count (wraps).
+ */
+uint32_t ADC_Scan_GetCount(void);
+
+/**
+ * @brief Queues a hardware-accumulated oversampling burst (single channel, EOA interrupt).
+ *        While the background scan is running the burst runs after the current sequence.
+ * @param channel External ADC channel (e.g., ADC_ExInputCH1), VDD reference.
+ * @param log2_samples Burst length 2^log2_samples (1..ADC_OVERSAMPLE_MAX_LOG2).
+ * @return true if the job was accepted.
+ */
+bool ADC_Oversample_Start(uint32_t channel, uint8_t log2_samples);
+
+/**
+ * @brief Collects the result of the last oversampling burst (non-blocking).
+ * @param result Pointer to store the decimated result (12 + log2_samples/2 bits).
+ * @return true if a result was available.
+ */
+bool ADC_Oversample_GetResult(uint16_t *result);
+
+/**
+ * @brief Reads a channel with hardware-accumulated oversampling and waits for the result.
+ *        log2_samples = ADC_OVERSAMPLE_13BIT / ADC_OVERSAMPLE_14BIT for 13/14-bit output.
+ * @param channel External ADC channel (e.g., ADC_ExInputCH1).
+ * @param log2_samples Burst length 2^log2_samples (1..ADC_OVERSAMPLE_MAX_LOG2).
+ * @return Decimated result, or 0xFFFF on error / timeout.
+ */
+uint16_t ADC_ReadOversampled(uint32_t channel, uint8_t log2_samples);
+
+/**
+ * @brief Gets the supply voltage measured against the 1.5V bandgap by the reference pass.
+ * @return VDD in mV, or ADC_REFERENCE_VOLTAGE_MV until the first plausible measurement.
+ */
+uint16_t ADC_Vdd_Get_mV(void);
+
+/**
+ * @brief Gets the VDD correction factor (VDD_actual / ADC_REFERENCE_VOLTAGE_MV).
+ * @return Factor in Q12 (ADC_VDD_Q12_ONE = 1.0).
+ */
+uint16_t ADC_Vdd_GetCorrectionQ12(void);
+
+/**
+ * @brief Converts a raw VDD-referenced result to its value at nominal VDD.
+ *        Needed for signals that do not scale with VDD (CP). Ratiometric inputs (PP) need none.
+ * @param raw Raw 12-bit result against VDD.
+ * @return Compensated raw value (may exceed 4095 when VDD is above nominal).
+ */
+uint16_t ADC_Vdd_Compensate(uint16_t raw);
+
+/**
+ * @brief Converts a nominal-VDD raw value (e.g., a threshold) to the raw value read at the measured VDD.
+ * @param nominal_raw Raw value at nominal VDD.
+ * @return Raw value at the measured VDD, clamped to 4095.
+ */
+uint16_t ADC_Vdd_Uncompensate(uint16_t nominal_raw);
+
+/**
+ * @brief Gets the internal temperature from the background scan cache (integer math,
+ *        calibration read once at ADC_Driver_Init()). Does not touch ADC registers.
+ * @return Temperature in 0.01 deg C, or ADC_TEMPERATURE_INVALID if not converted yet.
+ */
+int16_t ADC_Temperature_Get_cC(void);
+
+/**
+ * @brief Arms the ADC analog watchdog on the CP channel with a raw band [low_raw, high_raw].
+ *        Requires the background scan; stopping the scan disarms the watch.
+ * @param low_raw Lowest raw value still inside the band.
+ * @param high_raw Highest raw value still inside the band.
+ */
+void ADC_CpWatch_Arm(uint16_t low_raw, uint16_t high_raw);
+
+/**
+ * @brief Disarms the CP window watch.
+ */
+void ADC_CpWatch_Disarm(void);
+
+/**
+ * @brief Checks whether CP left the armed band (latched until re-armed). Does not touch ADC registers.
+ * @return true if the band was left.
+ */
+bool ADC_CpWatch_Triggered(void);
+
+/**
+ * @brief Checks whether the CP window watch is armed.
+ * @return true if armed.
+ */
+bool ADC_CpWatch_IsArmed(void);
+
+/**
+ * @brief Reads the mean of a 2^log2_samples hardware burst on one channel (single EOA interrupt).
+ * @param channel External ADC channel (e.g., ADC_ExInputCH1), VDD reference.
+ * @param log2_samples Burst length 2^log2_samples (1..ADC_OVERSAMPLE_MAX_LOG2).
+ * @return Rounded 12-bit mean, or 0xFFFF on error / timeout.
+ */
+uint16_t ADC_Read_Channel_Average(uint32_t channel, uint8_t log2_samples);
+
+/**
+ * @brief Internal function to handle ADC interrupts.
+ *        Should be called from ADC_IRQHandler.
+ */
+void ADC_Driver_Handle_IRQ(void);
+
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,46 @@
+#ifndef __ADC_FILTER_H
+#define __ADC_FILTER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Filter stage limits
+#define ADC_FILTER_MEDIAN_MAX   5  // Largest median window (odd, kept small for the ISR)
+#define ADC_FILTER_IIR_MAX      8  // Largest IIR shift (y += (x - y) / 2^shift)
+
+/**
+ * @brief Per-channel filter pipeline: median-of-N -> first-order IIR -> level with hysteresis.
+ *        Integer math only; ADC_Filter_Update() runs once per sample from the ADC interrupt.
+ */
+typedef struct {
+    // Median stage
+    uint16_t median_buf[ADC_FILTER_MEDIAN_MAX];
+    uint8_t median_len;       // Window length (1 = bypass)
+    uint8_t median_index;     // Next write position
+
+    // IIR stage
+    uint8_t iir_shift;        // Coefficient 1/2^iir_shift (0 = bypass)
+    uint32_t iir_acc;         // Output scaled by 2^iir_shift
+
+    // Level stage
+    const uint16_t *thresholds; // Ascending level boundaries (may be NULL)
+    uint8_t threshold_count;
+    uint16_t hysteresis;      // Distance past a boundary needed to change level
+
+    // Outputs
+    volatile uint16_t output; // Filtered value
+    volatile uint8_t level;   // Number of boundaries below the output (with hysteresis)
+    volatile bool primed;     // At least one sample processed
+} ADC_Filter_t;
+
+// Function Prototypes
+bool ADC_Filter_Init(ADC_Filter_t *filter, uint8_t median_len, uint8_t iir_shift,
+                     const uint16_t *thresholds, uint8_t threshold_count, uint16_t hysteresis);
+void ADC_Filter_Reset(ADC_Filter_t *filter);                       // Forget history, re-prime on next sample
+uint16_t ADC_Filter_Update(ADC_Filter_t *filter, uint16_t sample); // Feed one sample (ISR safe)
+uint16_t ADC_Filter_GetOutput(const ADC_Filter_t *filter);
+uint8_t ADC_Filter_GetLevel(const ADC_Filter_t *filter);
+bool ADC_Filter_IsPrimed(const ADC_Filter_t *filter);
+uint8_t ADC_Filter_LevelOf(const uint16_t *thresholds, uint8_t threshold_count, uint16_t value); // No hysteresis
+
+#endif // __ADC_FILTER_H
@@ -77,12 +77,60 @@
 #define CP_ADC_GPIO_PORT        CW_GPIOA
 #define CP_ADC_GPIO_PIN         GPIO_PIN_1 // Example: PA1 for ADC Channel 1
 
+// CP sampling synchronised to the PWM: spare ATIM compare channels (no pin mapped)
+// fire the ADC scan in the middle of the high and the low plateau of each period
+#define CP_SYNC_HIGH_TRIGGER    ATIM_ADC_TRIGGER_CH1A // ATIM CH1A compare -> ADC start
+#define CP_SYNC_LOW_TRIGGER     ATIM_ADC_TRIGGER_CH3A // ATIM CH3A compare -> ADC start
+#define CP_SYNC_HIGH_FLAG       ATIM_IT_C1AF          // Tells the ADC ISR which plateau was sampled
+#define CP_SYNC_LOW_FLAG        ATIM_IT_C3AF
+
 // Define which peripherals/pins are used 
 // Note: ADC_ExInputCH2 corresponds to PA04 according to cw32f003_adc.h
 #define PP_ADC_CHANNEL          ADC_ExInputCH2 // Use the library constant directly
 #define PP_ADC_GPIO_PORT        CW_GPIOA
 #define PP_ADC_GPIO_PIN         GPIO_PIN_4 // PA04 for ADC Channel 2
 
+// HLW8032 metrology calibration (board specific, see HLW8032 datasheet)
+// V = Vparam / Vreg * Kv, I = Iparam / Ireg * Ki, P = Pparam / Preg * Kv * Ki
+#define HLW_KV_MILLI            1880 // Kv x1000: voltage divider ratio (4 x 470k : 1k)
+#define HLW_KI_MILLI            1000 // Ki x1000: 1 / (shunt in mOhm), 1 mOhm shunt
+
+// HLW8032 link liveness (the chip sends one frame every 50 ms)
+#define HLW_FRAME_PERIOD_MS     50
+#define HLW_STALE_TIMEOUT_MS    (3 * HLW_FRAME_PERIOD_MS) // V/I/P older than this are reported invalid
+#define HLW_LINK_TIMEOUT_MS     (5 * HLW_FRAME_PERIOD_MS) // Raises ERROR_HLW_UART_TIMEOUT while charging
+
+// Hardware fast-trip: VC1 compares a current-sense / fault input against the VDD divider
+// and opens the contactor from its ISR (set FAST_TRIP_ENABLE to 0 if the board lacks the input)
+#define FAST_TRIP_ENABLE        1
+// Sense input: PB05 is VC1 input channel 3 (cw32f003_vc.h); pin and channel change together
+#define FAST_TRIP_GPIO_PORT     CW_GPIOB
+#define FAST_TRIP_GPIO_PIN      GPIO_PIN_5        // PB05
+#define FAST_TRIP_GPIO_CLK_ENABLE() __RCC_GPIOB_CLK_ENABLE()
+#define FAST_TRIP_VC_INPUT_P    VC_InputP_Ch3     // Comparator + input: VC1 channel 3 = PB05
+#define FAST_TRIP_DIV_VALUE     47                // Threshold = VDD * (47 + 1) / 64 = 2.475 V at 3.3 V
+#define FAST_TRIP_IRQ_PRIORITY  0                 // Highest: pre-empts the ADC/UART ISRs
+#define FAST_TRIP_CP_HOLD_MS    1000              // Minimum time CP stays at the fault level after a trip
+
+// Energy journal: the last two 512-byte flash pages (0x4C00-0x4FFF) are kept out of the
+// linker's IROM range in MDK/Project.uvprojx
+#define JOURNAL_PAGE_A          38
+#define JOURNAL_PAGE_B          39
+#define JOURNAL_SAVE_INTERVAL_WH 100 // Journal the lifetime total at least every 100 Wh while charging
+
+// Tokenized logging (log.h): messages above LOG_LEVEL are compiled out
+// 0 = off, 1 = error, 2 = warn, 3 = info, 4 = debug
+#ifndef LOG_LEVEL
+#define LOG_LEVEL               3    // May be overridden per build (-DLOG_LEVEL=1)
+#endif
+#define LOG_RING_SIZE           128  // Power of two; ~10 records of 4-12 bytes
+
+// Idle power management: deep sleep between AWT wake-ups while no vehicle is connected
+#define LOWPOWER_DEEP_SLEEP_ENABLE 1
+#define LOWPOWER_LSI_HZ         32800 // LSI clock feeding the AWT (datasheet typical)
+#define LOWPOWER_IDLE_WAKE_MS   100   // Deep sleep interval in IDLE, well inside the ~500 ms IWDT timeout
+#define LOWPOWER_AWAKE_MS       20    // Awake time per wake-up: CP scans through the filter + SM ticks
+
 
 
 #endif // __CONFIG_H
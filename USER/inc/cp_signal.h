@@ -2,6 +2,7 @@
 #define __CP_SIGNAL_H
 
 #include "stdint.h" // Use standard integer types
+#include <stdbool.h>
 
 // Define CP Voltage States (Values are approximate and need calibration with real hardware)
 // Based on typical interpretations of GB/T 20234.2-2015 / IEC 61851-1 Mode 3
@@ -20,5 +21,8 @@ typedef enum {
 void CP_Signal_Init(void); // Initialize PWM output and ADC input for CP
 void CP_SetMaxCurrentPWM(uint8_t max_current_amps); // Set PWM duty cycle based on allowed current
 CP_State_t CP_ReadState(void); // Read ADC voltage and return the interpreted CP state
+bool CP_StateChangePending(void); // CP left the band of the last state (ADC window watchdog)
+void CP_StopWatch(void); // Disarm the window watchdog while CP is driven away from the last state
+bool CP_GetPlateauVoltages(uint16_t *high_mv, uint16_t *low_mv); // High/low PWM plateau voltages in mV
 
 #endif // __CP_SIGNAL_H
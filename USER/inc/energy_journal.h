@@ -0,0 +1,45 @@
+#ifndef __ENERGY_JOURNAL_H
+#define __ENERGY_JOURNAL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @brief One journal record (16 bytes, 32 per 512-byte flash page).
+ *        The CRC is the last field written, so a record torn by a reset never validates.
+ */
+typedef struct {
+    uint32_t sequence;        // Monotonic record number, highest valid one is the newest
+    uint32_t lifetime_wh;     // Lifetime energy total
+    uint32_t session_mwh;     // Energy of the last session
+    uint16_t session_count;   // Number of sessions started
+    uint16_t crc;             // CRC16 (CCITT-FALSE) over the preceding 14 bytes
+} Journal_Record_t;
+
+/**
+ * @brief Scans the journal pages for the newest valid record (bounded: one pass over both pages).
+ * @param latest Filled with the newest record if one is found.
+ * @return true if a valid record was found, false if the journal is empty.
+ */
+bool Journal_Init(Journal_Record_t *latest);
+
+/**
+ * @brief Queues a record for writing; Journal_Poll() writes it in small steps.
+ *        A record queued while another is being written replaces any earlier queued one.
+ * @param record Payload (sequence and crc are filled in by the journal).
+ */
+void Journal_Append(const Journal_Record_t *record);
+
+/**
+ * @brief Runs one bounded step of a pending write: a page erase or a few bytes of a record.
+ *        Call from the main loop.
+ */
+void Journal_Poll(void);
+
+/**
+ * @brief Checks whether a record is queued or being written.
+ * @return true while the journal has work pending.
+ */
+bool Journal_IsBusy(void);
+
+#endif // __ENERGY_JOURNAL_H
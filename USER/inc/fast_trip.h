@@ -0,0 +1,39 @@
+#ifndef __FAST_TRIP_H
+#define __FAST_TRIP_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @brief Initializes the VC1 fast-trip channel (no-op when FAST_TRIP_ENABLE is 0).
+ *        The comparator output is digitally filtered and blanked around the CP PWM edges;
+ *        a rising edge raises VC1_IRQn at FAST_TRIP_IRQ_PRIORITY.
+ */
+void FastTrip_Init(void);
+
+/**
+ * @brief Re-arms the comparator after a trip has been handled and releases CP from the
+ *        fault level (State F) the trip forced. Refused for FAST_TRIP_CP_HOLD_MS after the
+ *        trip and while the input is above the threshold; until then CP stays at State F
+ *        whatever duty cycle is set.
+ * @return true if re-armed (or nothing was latched), false if the trip is still held.
+ */
+bool FastTrip_Rearm(void);
+
+/**
+ * @brief Checks whether the comparator has tripped since the last re-arm.
+ * @return true after a trip (latched until FastTrip_Rearm()).
+ */
+bool FastTrip_IsTripped(void);
+
+/**
+ * @brief Internal function to handle the comparator interrupt.
+ *        Should be called from VC1_IRQHandler.
+ * @note Response: comparator (High response) + digital filter (15 PCLK, 0.31 us at 48 MHz)
+ *       + exception entry (15 cycles) + Contactor_Open() GPIO write (~30 cycles):
+ *       roughly 1.5 us from threshold crossing to the contactor drive pin, outside the
+ *       blanking window. Relay opening time comes on top.
+ */
+void FastTrip_Handle_IRQ(void);
+
+#endif // __FAST_TRIP_H
@@ -0,0 +1,69 @@
+#ifndef __FMT_H
+#define __FMT_H
+
+#include <stdint.h>
+
+// Number formatting into caller buffers: no libc, no division, no floating point.
+// Every function writes a NUL-terminated string at buf and returns its length
+// (without the NUL), so calls can be chained: n = Fmt_Fixed(buf, ...); n += Fmt_Str(buf + n, " A");
+
+// --- Longest output of each function (add 1 for the NUL) ---
+#define FMT_U32_LEN     10  // 4294967295
+#define FMT_I32_LEN     11  // -2147483648
+#define FMT_FIXED_LEN   12  // -21474836.48 or -0.000000005
+#define FMT_HEX_LEN     8   // FFFFFFFF
+
+/**
+ * @brief Formats an unsigned decimal number.
+ * @param buf Output, at least FMT_U32_LEN + 1 bytes.
+ * @param value Number to format.
+ * @return String length.
+ */
+uint8_t Fmt_U32(char *buf, uint32_t value);
+
+/**
+ * @brief Formats a signed decimal number ('-' for negative values).
+ * @param buf Output, at least FMT_I32_LEN + 1 bytes.
+ * @param value Number to format.
+ * @return String length.
+ */
+uint8_t Fmt_I32(char *buf, int32_t value);
+
+/**
+ * @brief Formats a fixed-point number: value / 10^decimals, with exactly that many decimals.
+ *        E.g. (123, 1) -> "12.3", (5, 2) -> "0.05", (-5, 1) -> "-0.5", (42, 0) -> "42".
+ *        Scale (and round) to the wanted resolution first, e.g. (mA + 50) / 100 for 0.1 A.
+ * @param buf Output, at least FMT_FIXED_LEN + 1 bytes.
+ * @param value Number in units of 10^-decimals.
+ * @param decimals Digits after the point (0-9).
+ * @return String length.
+ */
+uint8_t Fmt_Fixed(char *buf, int32_t value, uint8_t decimals);
+
+/**
+ * @brief Formats an uppercase hexadecimal number, zero-padded to a fixed number of digits.
+ * @param buf Output, at least digits + 1 bytes.
+ * @param value Number to format; higher digits than requested are dropped.
+ * @param digits Number of hex digits (1-8).
+ * @return String length.
+ */
+uint8_t Fmt_Hex(char *buf, uint32_t value, uint8_t digits);
+
+/**
+ * @brief Copies a string (for units and labels between numbers).
+ * @param buf Output, at least strlen(str) + 1 bytes.
+ * @param str String to copy.
+ * @return String length.
+ */
+uint8_t Fmt_Str(char *buf, const char *str);
+
+/**
+ * @brief Right-aligns a formatted string in place by padding with leading spaces.
+ * @param buf String of length len; at least width + 1 bytes.
+ * @param len Current length.
+ * @param width Field width; nothing changes if len >= width.
+ * @return New length.
+ */
+uint8_t Fmt_AlignRight(char *buf, uint8_t len, uint8_t width);
+
+#endif // __FMT_H
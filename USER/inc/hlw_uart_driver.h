@@ -11,16 +11,12 @@ extern "C" {
 
 /* Defines -------------------------------------------------------------------*/
 // Define buffer size - adjust if needed for HLW8032 packet handling
-#define HLW_UART_BUFFER_SIZE 64 // Example size, ensure it's >= 24 bytes
+#define HLW_UART_BUFFER_SIZE 64 // Power of two (see ring_buffer.h), ensure it's >= 24 bytes
 
 /* Typedefs ------------------------------------------------------------------*/
-// Simple Ring Buffer Structure
-typedef struct {
-    uint8_t buffer[HLW_UART_BUFFER_SIZE];
-    volatile uint16_t head;
-    volatile uint16_t tail;
-    volatile uint16_t count;
-} HLW_RingBuffer_t;
+// Byte sink called from the UART2 ISR for every received byte.
+// When registered, received bytes bypass the RX ring buffer.
+typedef void (*HLW_UART_RxHandler_t)(uint8_t byte);
 
 /* Function Prototypes -------------------------------------------------------*/
 
@@ -43,6 +39,13 @@ int16_t HLW_UART_Read(void);
  */
 bool HLW_UART_DataAvailable(void);
 
+/**
+ * @brief Registers a byte sink that consumes received bytes directly in ISR context.
+ * @param handler Function called for each received byte, or NULL to use the RX ring buffer.
+ * @note The handler runs inside UART2_IRQHandler and must be short and non-blocking.
+ */
+void HLW_UART_SetRxHandler(HLW_UART_RxHandler_t handler);
+
 /**
  * @brief Internal function to handle UART reception from ISR.
  *        Should be called from UART2_IRQHandler when RC interrupt occurs.
@@ -0,0 +1,72 @@
+#ifndef __LOG_H
+#define __LOG_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "config.h"      // For LOG_LEVEL and LOG_RING_SIZE
+
+// --- Log levels (a message is compiled in when its level <= LOG_LEVEL) ---
+#define LOG_LEVEL_NONE   0
+#define LOG_LEVEL_ERROR  1
+#define LOG_LEVEL_WARN   2
+#define LOG_LEVEL_INFO   3
+#define LOG_LEVEL_DEBUG  4
+
+#include "log_catalog.h"
+
+// --- Wire format ---
+// Record: 0xA5, message ID, GetTick() bits 0..15 (LE), then nargs x 32-bit argument (LE).
+// The sync byte is never valid ASCII, so records can share the port with plain text.
+#define LOG_SYNC_BYTE    0xA5
+#define LOG_MAX_ARGS     2
+#define LOG_HEADER_LEN   4
+#define LOG_RECORD_MAX   (LOG_HEADER_LEN + 4 * LOG_MAX_ARGS)
+
+// --- Catalogue-derived constants: LOG_ID_<name>, LOG_LVL_<name>, LOG_NARGS_<name> ---
+#define LOG_X_ID(name, level, nargs, fmt)     LOG_ID_##name,
+#define LOG_X_LVL(name, level, nargs, fmt)    LOG_LVL_##name = (level),
+#define LOG_X_NARGS(name, level, nargs, fmt)  LOG_NARGS_##name = (nargs),
+
+typedef enum { LOG_CATALOG(LOG_X_ID) LOG_ID_COUNT } Log_Id_t;
+enum { LOG_CATALOG(LOG_X_LVL) LOG_LVL_END_ };
+enum { LOG_CATALOG(LOG_X_NARGS) LOG_NARGS_END_ };
+
+// --- Call-site macros ---
+// LOGn(name, ...) emits catalogue message <name> with n arguments. Messages above LOG_LEVEL
+// compile to nothing, and an argument count that does not match the catalogue fails to compile.
+#define LOG_CHECK_NARGS(name, n)  ((void)sizeof(char[(LOG_NARGS_##name == (n)) ? 1 : -1]))
+#define LOG_ENABLED(name)         (LOG_LVL_##name <= LOG_LEVEL)
+
+#define LOG0(name) do { LOG_CHECK_NARGS(name, 0); \
+    if (LOG_ENABLED(name)) { Log_Write(LOG_ID_##name, 0, 0, 0); } } while (0)
+#define LOG1(name, a) do { LOG_CHECK_NARGS(name, 1); \
+    if (LOG_ENABLED(name)) { Log_Write(LOG_ID_##name, 1, (uint32_t)(a), 0); } } while (0)
+#define LOG2(name, a, b) do { LOG_CHECK_NARGS(name, 2); \
+    if (LOG_ENABLED(name)) { Log_Write(LOG_ID_##name, 2, (uint32_t)(a), (uint32_t)(b)); } } while (0)
+
+/**
+ * @brief Queues one record. Safe from ISRs; interrupts are masked only for the copy.
+ *        When the ring is full the record is dropped and counted; a DROPPED record
+ *        carrying the count goes out once there is room again.
+ *        Use the LOGn() macros rather than calling this directly.
+ */
+void Log_Write(uint8_t id, uint8_t nargs, uint32_t a, uint32_t b);
+
+/**
+ * @brief Moves queued records into the debug UART TX buffer, as far as it has room.
+ *        Never waits. Run as a background task.
+ */
+void Log_Drain(void);
+
+/**
+ * @brief Checks whether Log_Drain() has work it can do now.
+ * @return true if records are queued and the UART TX buffer has room.
+ */
+bool Log_Pending(void);
+
+/**
+ * @brief Gets the total number of records dropped because the ring was full.
+ */
+uint32_t Log_GetDropped(void);
+
+#endif // __LOG_H
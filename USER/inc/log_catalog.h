@@ -0,0 +1,37 @@
+#ifndef __LOG_CATALOG_H
+#define __LOG_CATALOG_H
+
+// Log message catalogue: the single format table for the firmware and the host decoder
+// (tools/log_decode.py parses this file). Append new messages at the end of the list; the
+// position of a row is its ID on the wire, so reordering breaks decoding of older logs.
+//
+// X(name, level, nargs, "format")  -- format uses %d (signed), %u, %X on 32-bit arguments
+#define LOG_CATALOG(X) \
+    X(DROPPED,                LOG_LEVEL_WARN,  1, "LOG: %u records dropped (ring full)") \
+    X(ERR_REPORTED,           LOG_LEVEL_ERROR, 2, "ERROR: Code %d at line %u") \
+    X(ERR_SAFETY,             LOG_LEVEL_ERROR, 1, "SAFETY CRITICAL ERROR %d: Opening contactor.") \
+    X(SM_INIT,                LOG_LEVEL_INFO,  0, "Charging State Machine Initialized. State: IDLE") \
+    X(SM_JOURNAL_RESTORED,    LOG_LEVEL_INFO,  2, "Journal restored: %u Wh, %u sessions") \
+    X(SM_PERSISTENT_ERROR,    LOG_LEVEL_WARN,  1, "SM: Persistent Error Detected (%d). Forcing FAULT state.") \
+    X(SM_CP_FAULT,            LOG_LEVEL_WARN,  0, "SM: CP Fault Detected. Forcing FAULT state.") \
+    X(SM_PP_FAULT,            LOG_LEVEL_WARN,  0, "SM: PP Fault Detected!") \
+    X(SM_CONNECTED,           LOG_LEVEL_INFO,  2, "SM: Vehicle Connected. Cable: %uA, Max Charge: %uA") \
+    X(SM_STATE_D_FAULT,       LOG_LEVEL_WARN,  0, "SM: State D detected - treating as Fault.") \
+    X(SM_CHARGE_REQUESTED,    LOG_LEVEL_INFO,  0, "SM: Charging Requested (State C).") \
+    X(SM_DISCONNECTED,        LOG_LEVEL_INFO,  0, "SM: Vehicle Disconnected.") \
+    X(SM_CONTACTOR_CLOSED,    LOG_LEVEL_INFO,  0, "SM: Contactor Closed Confirmed. Charging Active.") \
+    X(SM_CONTACTOR_CLOSE_FAIL, LOG_LEVEL_ERROR, 0, "SM: Contactor Close FAILED! Entering Fault.") \
+    X(SM_CONTACTOR_OPENED,    LOG_LEVEL_INFO,  0, "SM: Contactor Opened Confirmed.") \
+    X(SM_CONTACTOR_OPEN_FAIL, LOG_LEVEL_ERROR, 0, "SM: Contactor Open FAILED! Entering Fault.") \
+    X(SM_EV_STOPPED,          LOG_LEVEL_INFO,  0, "SM: Charging Stopped by EV (State B). Opening contactor.") \
+    X(SM_EV_UNPLUGGED,        LOG_LEVEL_WARN,  0, "SM: Vehicle Disconnected during Charging. Opening contactor.") \
+    X(SM_HLW_LINK_LOST,       LOG_LEVEL_ERROR, 0, "SM: HLW8032 link lost while charging! Entering Fault.") \
+    X(SM_OVERCURRENT,         LOG_LEVEL_ERROR, 1, "SM: Overcurrent trip (%d). Entering Fault.") \
+    X(SM_VENTILATION,         LOG_LEVEL_WARN,  0, "SM: State D (Ventilation) not supported. Entering Fault.") \
+    X(SM_FAULT_CLEARED,       LOG_LEVEL_INFO,  0, "SM: Fault condition cleared (CP State A & Contactor Open). Returning to IDLE.") \
+    X(SM_INVALID_STATE,       LOG_LEVEL_ERROR, 1, "SM: Invalid State (%d)! Forcing to IDLE.") \
+    X(SM_STATE_CHANGE,        LOG_LEVEL_INFO,  2, "SM: State Change %d -> %d") \
+    X(OCP_TRIP,               LOG_LEVEL_ERROR, 2, "OCP: Trip %d (tolerance %u dA)") \
+    X(JOURNAL_FLASH_ERROR,    LOG_LEVEL_ERROR, 2, "Journal: flash error 0x%X at slot %u")
+
+#endif // __LOG_CATALOG_H
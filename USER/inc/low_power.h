@@ -0,0 +1,44 @@
+#ifndef __LOW_POWER_H
+#define __LOW_POWER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @brief Sleep residency counters, for estimating the average supply current.
+ */
+typedef struct {
+    uint32_t sleeps;          // Plain WFI sleeps (woken by SysTick, UART, ADC, ...)
+    uint32_t deep_sleeps;     // Deep sleeps entered
+    uint32_t deep_sleep_ms;   // Total time spent in deep sleep
+    uint32_t early_wakes;     // Deep sleeps ended by another interrupt before the AWT
+} LowPower_Stats_t;
+
+/**
+ * @brief Configures the AWT (LSI clocked) as the deep sleep wake-up timer.
+ */
+void LowPower_Init(void);
+
+/**
+ * @brief Sleeps until the next interrupt if no scheduler task is due.
+ *        Call from the main loop when Sched_Dispatch() found nothing to run.
+ * @param deep_allowed true if the application can tolerate stopped peripheral clocks
+ *        (no charging, no metering needed); the MCU then deep-sleeps for up to
+ *        LOWPOWER_IDLE_WAKE_MS once it has been awake for LOWPOWER_AWAKE_MS.
+ * @return true if the core was in deep sleep (UART/ADC clocks were stopped).
+ */
+bool LowPower_Idle(bool deep_allowed);
+
+/**
+ * @brief Gets the sleep residency counters.
+ * @param stats Filled with a copy of the counters.
+ */
+void LowPower_GetStats(LowPower_Stats_t *stats);
+
+/**
+ * @brief Internal function to handle the AWT interrupt.
+ *        Should be called from AWT_IRQHandler.
+ */
+void LowPower_Handle_AWT_IRQ(void);
+
+#endif // __LOW_POWER_H
@@ -0,0 +1,62 @@
+#ifndef __OVERCURRENT_H
+#define __OVERCURRENT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// --- Trip characteristic (IEC 61851-1 tolerance on the CP-advertised current) ---
+#define OCP_TOLERANCE_SPLIT_A      20   // Up to 20 A: limit + 2 A, above: limit + 10 %
+#define OCP_TOLERANCE_ADD_DA       20   // +2.0 A (in 0.1 A units)
+#define OCP_TOLERANCE_PERCENT      110
+#define OCP_GRACE_MS               5000 // EV adaptation time after the limit is set or lowered
+#define OCP_OVERSHOOT_DEADLINE_MS  10000 // Continuous overshoot above tolerance trips after this
+#define OCP_I2T_REF_PERCENT        125  // I2t reference point: 125 % of the tolerance current...
+#define OCP_I2T_TRIP_MS_AT_REF     2000 // ...trips after 2 s (longer below, shorter above)
+#define OCP_HARD_TRIP_PERCENT      150  // Instantaneous trip above this share of the tolerance current
+
+/**
+ * @brief Reason for an overcurrent trip.
+ */
+typedef enum {
+    OCP_TRIP_NONE,
+    OCP_TRIP_HARD,       // Instantaneous threshold exceeded
+    OCP_TRIP_I2T,        // Accumulated I2t budget used up
+    OCP_TRIP_DEADLINE    // Tolerance exceeded for longer than OCP_OVERSHOOT_DEADLINE_MS
+} OCP_Trip_t;
+
+/**
+ * @brief Arms the protection for a charging session (clears any previous trip).
+ * @param limit_amps Current advertised on CP (A).
+ */
+void OCP_Arm(uint8_t limit_amps);
+
+/**
+ * @brief Changes the advertised limit while armed; a lower limit restarts the grace period.
+ * @param limit_amps Current advertised on CP (A).
+ */
+void OCP_SetLimit(uint8_t limit_amps);
+
+/**
+ * @brief Disarms the protection (contactor opened by the state machine).
+ */
+void OCP_Disarm(void);
+
+/**
+ * @brief Evaluates a new current sample. Call after each decoded HLW8032 frame.
+ *        On a trip, opens the contactor at once and reports ERROR_OVERCURRENT.
+ * @note Worst-case hard-trip latency from current onset to Contactor_Open(): one HLW8032
+ *       measurement period (50 ms) + frame transfer at 4800 baud (24 x 11 bits, ~55 ms)
+ *       + main loop turnaround, i.e. about 110 ms, plus the relay's own opening time.
+ * @param current_ma Measured RMS current (mA).
+ * @param now_ms Time stamp of the sample (GetTick()).
+ * @return Trip reason, OCP_TRIP_NONE while within limits.
+ */
+OCP_Trip_t OCP_Update(uint32_t current_ma, uint32_t now_ms);
+
+/**
+ * @brief Gets the reason of the last trip since OCP_Arm().
+ * @return Trip reason, OCP_TRIP_NONE if not tripped.
+ */
+OCP_Trip_t OCP_GetTrip(void);
+
+#endif // __OVERCURRENT_H
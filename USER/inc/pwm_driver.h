@@ -13,5 +13,13 @@ bool PWM_Set_Frequency(uint32_t freqHz); // Added prototype
 bool PWM_Set_DutyCycle(uint8_t dutyCyclePercent); // Added prototype
 uint32_t PWM_Get_Frequency(void);
 uint8_t PWM_Get_DutyCycle(void);
+bool PWM_EnableAdcSync(bool enable); // Trigger the ADC in the middle of each high/low plateau
+void PWM_ReleaseOutput(void); // Back to PWM after PWM_FORCE_OUTPUT_LOW()
+
+// Forces the CP output (ATIM CH2B) inactive (constant low) with one register write, leaving
+// the duty cycle untouched: safe from an ISR that pre-empts PWM_Set_DutyCycle(). The output
+// stays low whatever duty is set until PWM_ReleaseOutput(). FLTR is otherwise written only
+// during init.
+#define PWM_FORCE_OUTPUT_LOW()  (CW_ATIM->FLTR &= ~ATIM_FLTR_OCM2BFLT2B_Msk) // OCM2B = forced inactive
 
 #endif // __PWM_DRIVER_H
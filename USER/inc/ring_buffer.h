@@ -0,0 +1,69 @@
+#ifndef __RING_BUFFER_H
+#define __RING_BUFFER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @brief Single-producer / single-consumer byte ring.
+ *        head is written only by the producer and tail only by the consumer (one of them
+ *        typically an ISR), so no critical sections are needed. Both indices run freely
+ *        and are masked on access; the fill level is head - tail.
+ */
+typedef struct {
+    volatile uint8_t *buffer;   // Storage, size is a power of two
+    uint16_t mask;              // size - 1
+    volatile uint16_t head;     // Producer: next slot to write
+    volatile uint16_t tail;     // Consumer: next slot to read
+} RingBuffer_t;
+
+/**
+ * @brief Initializes an empty ring on caller-provided storage.
+ * @param rb Ring to initialize.
+ * @param storage Buffer of size bytes.
+ * @param size Power of two, 2..32768.
+ * @return true if successful, false if size is not a power of two in range.
+ */
+bool RingBuffer_Init(RingBuffer_t *rb, volatile uint8_t *storage, uint16_t size);
+
+/**
+ * @brief Adds one byte (producer side).
+ * @return true if successful, false if the ring is full.
+ */
+bool RingBuffer_Put(RingBuffer_t *rb, uint8_t data);
+
+/**
+ * @brief Removes one byte (consumer side).
+ * @return true if successful, false if the ring is empty.
+ */
+bool RingBuffer_Get(RingBuffer_t *rb, uint8_t *data);
+
+/**
+ * @brief Adds up to length bytes (producer side), publishing them with one index update.
+ * @return Number of bytes added (less than length if the ring filled up).
+ */
+uint16_t RingBuffer_PutBulk(RingBuffer_t *rb, const uint8_t *data, uint16_t length);
+
+/**
+ * @brief Removes up to length bytes (consumer side), releasing them with one index update.
+ * @return Number of bytes removed (less than length if the ring ran empty).
+ */
+uint16_t RingBuffer_GetBulk(RingBuffer_t *rb, uint8_t *data, uint16_t length);
+
+/**
+ * @brief Gets the number of bytes queued (exact for the consumer, a lower bound of the
+ *        free space for the producer).
+ */
+uint16_t RingBuffer_Count(const RingBuffer_t *rb);
+
+/**
+ * @brief Checks whether the ring holds no data.
+ */
+bool RingBuffer_IsEmpty(const RingBuffer_t *rb);
+
+/**
+ * @brief Checks whether the ring has no free slot.
+ */
+bool RingBuffer_IsFull(const RingBuffer_t *rb);
+
+#endif // __RING_BUFFER_H
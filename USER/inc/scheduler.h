@@ -0,0 +1,81 @@
+#ifndef __SCHEDULER_H
+#define __SCHEDULER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define SCHED_MAX_TASKS  8  // Size of the per-task statistics table
+
+/**
+ * @brief What to do when a periodic task falls behind its release times.
+ */
+typedef enum {
+    SCHED_CATCH_UP, // Run every missed release, back to back (counters, integrators)
+    SCHED_SKIP      // Drop missed releases and realign to the period (state polling, UI)
+} Sched_Policy_t;
+
+/**
+ * @brief One row of the task table. Table order is priority order (first = highest).
+ */
+typedef struct {
+    const char *name;
+    void (*run)(void);        // Task body, runs to completion
+    bool (*ready)(void);      // Optional event: releases the task at once when true (may be NULL)
+    uint16_t period_ms;       // Release period, 0 = event-driven only
+    uint16_t offset_ms;       // First release after Sched_Init(), spreads tasks over the ticks
+    uint16_t budget_us;       // Execution time budget; longer runs count as overruns
+    Sched_Policy_t policy;
+} Sched_Task_t;
+
+/**
+ * @brief Per-task execution statistics.
+ */
+typedef struct {
+    uint32_t runs;
+    uint16_t last_us;         // Execution time of the latest run
+    uint16_t wcet_us;         // Worst-case execution time seen (high-water mark)
+    uint16_t overruns;        // Runs longer than budget_us
+    uint16_t misses;          // Releases started after the next release was already due
+} Sched_Stats_t;
+
+/**
+ * @brief Installs the task table and schedules the first releases.
+ * @param tasks Task table (must stay valid, usually static const).
+ * @param count Number of rows, at most SCHED_MAX_TASKS.
+ * @return true if successful, false on invalid parameters.
+ */
+bool Sched_Init(const Sched_Task_t *tasks, uint8_t count);
+
+/**
+ * @brief Runs the highest-priority due task, if any. Call from the main loop.
+ * @return true if a task ran.
+ */
+bool Sched_Dispatch(void);
+
+/**
+ * @brief Checks whether any task is due, without running it.
+ *        Call with interrupts disabled right before sleeping to close the race with ISRs.
+ * @return true if Sched_Dispatch() would run a task now.
+ */
+bool Sched_IsDue(void);
+
+/**
+ * @brief Realigns periodic releases that fell behind while the tick was suspended
+ *        (deep sleep), so the skipped time is not counted as deadline misses.
+ */
+void Sched_Realign(void);
+
+/**
+ * @brief Gets the statistics of one task.
+ * @param index Row in the task table.
+ * @param stats Filled with a copy of the statistics.
+ * @return true if successful, false if index is out of range.
+ */
+bool Sched_GetStats(uint8_t index, Sched_Stats_t *stats);
+
+/**
+ * @brief Clears all statistics (e.g. after start-up transients).
+ */
+void Sched_ResetStats(void);
+
+#endif // __SCHEDULER_H
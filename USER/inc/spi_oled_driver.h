@@ -3,6 +3,7 @@
 
 #include "cw32f003.h"
 #include "base_types.h"
+#include "cw32f003_gpio.h" // GPIO_FastSet()/GPIO_FastClear() for the pin macros
 #include <stdbool.h> // Include for bool type
 
 //-----------------OLED SPI Pin Definition----------------
@@ -26,14 +27,15 @@
 //-----------------OLED Definition----------------
 #define OLED_WIDTH              128
 #define OLED_HEIGHT             64 // Assuming 128x64 resolution for SSD1309
+#define OLED_PAGES              (OLED_HEIGHT / 8) // 8-pixel pages
 
-// Helper Macros for Pin Control (Using GPIO_WritePin)
-#define OLED_CS_LOW()           GPIO_WritePin(OLED_CS_PORT, OLED_CS_PIN, GPIO_Pin_RESET)
-#define OLED_CS_HIGH()          GPIO_WritePin(OLED_CS_PORT, OLED_CS_PIN, GPIO_Pin_SET)
-#define OLED_DC_LOW()           GPIO_WritePin(OLED_DC_PORT, OLED_DC_PIN, GPIO_Pin_RESET) // Command
-#define OLED_DC_HIGH()          GPIO_WritePin(OLED_DC_PORT, OLED_DC_PIN, GPIO_Pin_SET)  // Data
-#define OLED_RES_LOW()          GPIO_WritePin(OLED_RES_PORT, OLED_RES_PIN, GPIO_Pin_RESET)
-#define OLED_RES_HIGH()         GPIO_WritePin(OLED_RES_PORT, OLED_RES_PIN, GPIO_Pin_SET)
+// Helper Macros for Pin Control (inline single-store BSRR/BRR writes, also used by the TXE ISR)
+#define OLED_CS_LOW()           GPIO_FastClear(OLED_CS_PORT, OLED_CS_PIN)
+#define OLED_CS_HIGH()          GPIO_FastSet(OLED_CS_PORT, OLED_CS_PIN)
+#define OLED_DC_LOW()           GPIO_FastClear(OLED_DC_PORT, OLED_DC_PIN) // Command
+#define OLED_DC_HIGH()          GPIO_FastSet(OLED_DC_PORT, OLED_DC_PIN)   // Data
+#define OLED_RES_LOW()          GPIO_FastClear(OLED_RES_PORT, OLED_RES_PIN)
+#define OLED_RES_HIGH()         GPIO_FastSet(OLED_RES_PORT, OLED_RES_PIN)
 
 
 // Function Prototypes
@@ -42,7 +44,7 @@ bool OLED_Clear(void); // Changed return type
 bool OLED_SetCursor(uint8_t x, uint8_t y); // Changed return type
 void OLED_DrawPixel(uint8_t x, uint8_t y, uint8_t color); // color: 1=white, 0=black (Keep void if not checking status)
 void OLED_Fill(uint8_t data); // Keep void if not checking status
-void OLED_UpdateScreen(void); // Keep void if not checking status
+bool OLED_UpdateScreen(void); // Queues dirty spans of OLED_GRAM (no-op without OLED_USE_BUFFER)
 bool OLED_ShowChar(uint8_t x, uint8_t y, char chr, uint8_t size); // Changed return type
 bool OLED_ShowString(uint8_t x, uint8_t y, char *str, uint8_t size); // Changed return type
 bool OLED_ShowNum(uint8_t x, uint8_t y, uint32_t num, uint8_t len, uint8_t size); // Changed return type
@@ -56,8 +58,31 @@ bool OLED_WriteCommand(uint8_t command); // Changed return type
 bool OLED_WriteData(uint8_t data);       // Changed return type
 // Removed: void OLED_WriteBytes(uint8_t* data, uint16_t length, uint8_t controlByte); // I2C specific
 
-// Optional: Define if using a screen buffer
-// #define OLED_USE_BUFFER
+// --- Asynchronous transfers (SPI TXE interrupt) ---
+// A segment is up to OLED_SEG_CMD_MAX command bytes (DC low, copied) followed by
+// a data run (DC high, referenced). The blocking functions above wait for the queue first.
+#define OLED_TXQ_SIZE           8  // Queued segments (power of two): one per page
+#define OLED_SEG_CMD_MAX        3  // Page + column address commands
+
+typedef void (*OLED_TxDoneCallback_t)(void);
+
+/**
+ * @brief Queues one transfer segment and returns immediately; the SPI TXE interrupt sends it.
+ * @param cmd Command bytes (copied), or NULL if cmd_len is 0.
+ * @param cmd_len Number of command bytes (at most OLED_SEG_CMD_MAX).
+ * @param data Data bytes, or NULL if data_len is 0. Must stay valid until sent.
+ * @param data_len Number of data bytes.
+ * @return true if queued, false if the queue is full or the segment is invalid.
+ */
+bool OLED_QueueTransfer(const uint8_t *cmd, uint8_t cmd_len, const uint8_t *data, uint8_t data_len);
+bool OLED_IsBusy(void); // true while queued transfers are in progress
+void OLED_SetTxDoneCallback(OLED_TxDoneCallback_t callback); // Called from the ISR when the queue drains (NULL: none)
+void OLED_SPI_Handle_TXE(void); // Called from SPI_IRQHandler
+
+// Screen buffer (1 KB RAM): drawing functions update OLED_GRAM and track changed
+// column spans per page; OLED_UpdateScreen() sends only those to the panel.
+// Comment out to draw straight to the panel (no RAM cost, no flush needed).
+#define OLED_USE_BUFFER
 
 #ifdef OLED_USE_BUFFER
 extern uint8_t OLED_GRAM[OLED_WIDTH * OLED_HEIGHT / 8];
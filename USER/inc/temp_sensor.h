@@ -0,0 +1,31 @@
+#ifndef __TEMP_SENSOR_H
+#define __TEMP_SENSOR_H
+
+#include <stdint.h>
+
+// Internal temperature sensor conversion, integer only and free of hardware access so that
+// it also builds on the host (tools/temp_fixed_point_test.c).
+// Datasheet: Temp = T0 * 0.5 + 0.0924 * 1.5 * (AdcValue - Trim) in deg C
+// -> centi-degrees: T0 * 50 + 13.86 * (AdcValue - Trim), slope in Q10 (13.86 * 1024 = 14192.64)
+#define TEMP_SLOPE_CC_Q10   14193L
+#define TEMP_Q10_SHIFT      10
+
+/**
+ * @brief Folds the factory calibration into a Q10 centi-degree offset.
+ * @param t0_cal T0 calibration byte (unit: 0.5 deg C).
+ * @param trim_cal 1.5V reference trim.
+ * @return (T0 * 50 - 13.86 * Trim) in Q10 centi-degrees.
+ */
+int32_t TempSensor_CalOffset(uint8_t t0_cal, uint16_t trim_cal);
+
+/**
+ * @brief Converts a raw sensor result (1.5V reference) to centi-degrees.
+ *        One multiply, one add and one shift; no floating point.
+ * @param offset_cc_q10 Offset from TempSensor_CalOffset().
+ * @param raw Raw 12-bit result.
+ * @return Temperature in 0.01 deg C, saturated to [INT16_MIN + 1, INT16_MAX]
+ *         (INT16_MIN is left free as an "invalid" marker for callers).
+ */
+int16_t TempSensor_RawToCentiC(int32_t offset_cc_q10, uint16_t raw);
+
+#endif // __TEMP_SENSOR_H
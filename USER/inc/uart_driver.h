@@ -5,18 +5,10 @@
 #include <stdint.h>
 #include <stdbool.h> // Include for bool type
 
-// Define buffer sizes
+// Define buffer sizes (powers of two, see ring_buffer.h)
 #define UART_TX_BUFFER_SIZE 64
 #define UART_RX_BUFFER_SIZE 64
 
-// Ring buffer structure
-typedef struct {
-    volatile uint8_t buffer[UART_RX_BUFFER_SIZE]; // Use RX size for both for simplicity or define separate TX size
-    volatile uint16_t head;
-    volatile uint16_t tail;
-    volatile uint16_t count;
-} RingBuffer_t;
-
 // Function prototypes
 bool UART_Driver_Init(uint32_t baudRate); // Changed return type to bool
 // void UART_Send_Char(char c); // Replaced by non-blocking write or printf
@@ -24,8 +16,11 @@ bool UART_Driver_Init(uint32_t baudRate); // Changed return type to bool
 
 // New non-blocking functions
 bool UART_Write(const uint8_t* data, uint16_t length); // Non-blocking write (can still block if buffer full)
+bool UART_WriteString(const char* str); // Console text without printf (UART_Write() of the string)
 int16_t UART_Read(void); // Non-blocking read, returns -1 if no data
 bool UART_DataAvailable(void); // Check if data is available in RX buffer
+bool UART_TxIdle(void); // TX buffer empty and last byte sent (safe to stop the clock)
+uint16_t UART_TxSpace(void); // Free bytes in the TX buffer (UART_Write() of this many won't wait)
 
 // Interrupt handler helper functions (called from ISR)
 void UART_Driver_Handle_TXE(void);
@@ -2,9 +2,12 @@
 #define __UI_DISPLAY_H
 
 #include "stdint.h" // Use standard integer types
+#include <stdbool.h>
 
 // Function Prototypes
 void UI_Display_Init(void);     // Initialize the display (if needed beyond OLED_Init)
 void UI_UpdateDisplay(void);    // Update the OLED screen based on current charging state and data
+void UI_RequestUpdate(void);    // Mark the screen out of date; never waits on the display
+bool UI_UpdatePending(void);    // true if an update is requested and the display is free
 
 #endif // __UI_DISPLAY_H
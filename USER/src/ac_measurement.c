@@ -2,29 +2,83 @@
 #include "hlw_uart_driver.h" // Use the dedicated HLW UART driver
 #include "config.h"          // For HLW_UART_BAUDRATE
 #include "error_handler.h"   // Include the error handler
-#include <stdio.h>           // For debugging printf (can potentially be removed later)
-#include <string.h>          // For memcpy
+#include "cw32f003_systick.h" // For GetTick() (frame age)
+#include "uart_driver.h"     // For the start-up message
+#include <string.h>          // For memset
 
 // --- Defines ---
 #define HLW8032_PACKET_SIZE 24
-#define HLW8032_CURRENT_REG_INDEX 15 // Index of first byte of Current REG (0-based)
-#define HLW8032_VOLTAGE_REG_INDEX 6  // Index of first byte of Voltage REG
-#define HLW8032_POWER_REG_INDEX   18 // Index of first byte of Power REG
+#define HLW8032_STATE_INDEX       0  // State REG: 0x55 normal, 0xAA chip error, 0xFx overflow flags
+#define HLW8032_CHECK_INDEX       1  // Check REG, fixed 0x5A
+#define HLW8032_CHECK_BYTE        0x5A
+#define HLW8032_VOLTAGE_PARAM_INDEX 2  // Voltage parameter REG (3 bytes, MSB first)
+#define HLW8032_VOLTAGE_REG_INDEX   5  // Voltage REG
+#define HLW8032_CURRENT_PARAM_INDEX 8  // Current parameter REG
+#define HLW8032_CURRENT_REG_INDEX   11 // Current REG
+#define HLW8032_POWER_PARAM_INDEX   14 // Power parameter REG
+#define HLW8032_POWER_REG_INDEX     17 // Power REG
+#define HLW8032_UPDATE_INDEX        20 // Data update REG
+#define HLW8032_PF_INDEX            21 // PF pulse count (2 bytes, MSB first)
+#define HLW8032_CHECKSUM_START    2  // Checksum covers bytes 2..22
 #define HLW8032_CHECKSUM_INDEX    23 // Index of Checksum REG
+#define HLW8032_FRAME_BUFFERS     2  // Ping-pong: one filled by the ISR, one owned by the main loop
+
+// State REG
+#define HLW8032_STATE_NORMAL        0x55
+#define HLW8032_STATE_CHIP_ERROR    0xAA
+#define HLW8032_STATE_OVF_MASK      0xF0 // 0xFx: low nibble carries the flags below
+#define HLW8032_STATE_VOLTAGE_OVF   0x08 // Voltage REG overflow (voltage ~0)
+#define HLW8032_STATE_CURRENT_OVF   0x04 // Current REG overflow (current ~0)
+#define HLW8032_STATE_POWER_OVF     0x02 // Power REG overflow (power ~0)
+#define HLW8032_STATE_PARAM_ERROR   0x01 // Parameter REGs unusable
+
+// Data update REG
+#define HLW8032_UPDATE_VOLTAGE      0x40
+#define HLW8032_UPDATE_CURRENT      0x20
+#define HLW8032_UPDATE_POWER        0x10
+#define HLW8032_UPDATE_PF_OVF       0x80 // Toggles each time the 16-bit PF count wraps
+
+#define AC_PF_COUNT_MASK            0x1FFFFUL  // PF count extended to 17 bits with the overflow toggle
+#define AC_NWH_PER_MWH              1000000UL
+#define AC_ENERGY_CHUNK_PULSES      4000  // Keeps pulses * (nWh remainder) within 32 bits
+
+#define AC_POWER_FACTOR_ONE         1000 // Power factor scale (per-mille)
+#define HLW_KP_MILLI                (((uint32_t)HLW_KV_MILLI * HLW_KI_MILLI) / 1000) // Kv*Ki x1000
 
 // --- Global Variables ---
-static uint8_t hlw8032_rx_packet_buffer[HLW8032_PACKET_SIZE];
-static uint8_t hlw8032_rx_byte_count = 0;
-volatile bool hlw8032_packet_ready = false; // Flag set by ISR when 24 bytes received
+// Frames are assembled in place. The ISR only ever writes hlw8032_frame_buf[hlw8032_fill_index];
+// while hlw8032_packet_ready is set, the main loop owns hlw8032_frame_buf[hlw8032_ready_index].
+static uint8_t hlw8032_frame_buf[HLW8032_FRAME_BUFFERS][HLW8032_PACKET_SIZE];
+static uint8_t hlw8032_fill_index = 0;         // ISR-owned
+static uint8_t hlw8032_rx_byte_count = 0;      // ISR-owned
+static bool hlw8032_in_sync = false;           // ISR-owned: false while hunting for a header
+static volatile uint8_t hlw8032_ready_index = 0;
+volatile bool hlw8032_packet_ready = false; // Flag set by ISR when a valid frame is published
+
+static volatile AC_FrameStats_t hlw8032_stats;
+static uint32_t hlw8032_checksum_reported = 0; // Checksum failures already passed to the error handler
 
-// Storage for calculated values
-static float ac_rms_current = 0.0f;
-static float ac_rms_voltage = 0.0f;
-static float ac_active_power = 0.0f;
-// Add calibration factors if needed (from datasheet)
-// static float current_coeff = 1.0f; // Example: Amps per LSB
-// static float voltage_coeff = 1.0f; // Example: Volts per LSB
-// static float power_coeff = 1.0f;   // Example: Watts per LSB
+// Storage for calculated values (integer, updated from each valid frame)
+static uint32_t ac_voltage_mv = 0;
+static uint32_t ac_current_ma = 0;
+static uint32_t ac_power_mw = 0;
+static uint32_t ac_apparent_mva = 0;
+static uint16_t ac_power_factor_pm = 0;
+static bool ac_chip_error_reported = false;
+
+// Link liveness
+static uint32_t ac_last_update_tick = 0;   // GetTick() of the last decoded frame (or of init)
+static bool ac_data_seen = false;          // false until the first frame is decoded
+static bool ac_link_timeout_reported = false;
+
+// Energy metering from the PF pulse count
+static bool ac_pf_primed = false;          // false until the first frame sets the PF baseline
+static uint32_t ac_pf_last = 0;            // Last 17-bit PF count
+static uint32_t ac_energy_nwh = 0;         // Sub-mWh remainder (nWh, < AC_NWH_PER_MWH)
+static uint32_t ac_session_mwh = 0;
+static uint32_t ac_lifetime_wh = 0;
+static uint16_t ac_lifetime_mwh = 0;       // Sub-Wh part of the lifetime total (0..999)
+static uint16_t ac_session_count = 0;
 
 
 // --- Initialization ---
@@ -34,9 +88,29 @@ static float ac_active_power = 0.0f;
  */
 void AC_Measurement_Init(void)
 {
-    hlw8032_rx_byte_count = 0;
     hlw8032_packet_ready = false;
-    memset(hlw8032_rx_packet_buffer, 0, HLW8032_PACKET_SIZE);
+    hlw8032_fill_index = 0;
+    hlw8032_ready_index = 0;
+    hlw8032_rx_byte_count = 0;
+    hlw8032_in_sync = false;
+    hlw8032_checksum_reported = 0;
+    ac_voltage_mv = 0;
+    ac_current_ma = 0;
+    ac_power_mw = 0;
+    ac_apparent_mva = 0;
+    ac_power_factor_pm = 0;
+    ac_chip_error_reported = false;
+    ac_last_update_tick = GetTick(); // Age counts from init until the first frame
+    ac_data_seen = false;
+    ac_link_timeout_reported = false;
+    ac_pf_primed = false;
+    ac_energy_nwh = 0;
+    ac_session_mwh = 0;
+    memset(hlw8032_frame_buf, 0, sizeof(hlw8032_frame_buf));
+    memset((void *)&hlw8032_stats, 0, sizeof(hlw8032_stats));
+
+    // Feed received bytes straight into the frame assembler (no intermediate ring buffer)
+    HLW_UART_SetRxHandler(AC_Store_HLW8032_Byte);
 
     // Initialize UART2 for HLW8032
     if (!HLW_UART_Init(HLW_UART_BAUDRATE)) {
@@ -44,8 +118,8 @@ void AC_Measurement_Init(void)
          ErrorHandler_Handle(ERROR_UART2_INIT_FAILED, "AC_Measure_Init", __LINE__);
          // Depending on system design, might want to return or signal failure here
     } else {
-         // Keep printf for now, could be removed if handler provides enough info
-         printf("HLW8032 UART Initialized.\r\n");
+         // Start-up message, plain text on the debug UART
+         UART_WriteString("HLW8032 UART Initialized.\r\n");
     }
 }
 
@@ -54,72 +128,204 @@ void AC_Measurement_Init(void)
 /**
  * @brief Calculates the checksum for the HLW8032 packet.
  * @param buffer Pointer to the 24-byte packet buffer.
- * @return Calculated 8-bit checksum.
+ * @return Calculated 8-bit checksum (low byte of the sum of bytes 2..22).
  */
 static uint8_t Calculate_HLW8032_Checksum(const uint8_t* buffer)
 {
-    uint16_t sum = 0;
-    for (int i = 0; i < HLW8032_CHECKSUM_INDEX; i++) { // Sum first 23 bytes
-        sum += buffer[i];
+    uint8_t sum = 0;
+    for (int i = HLW8032_CHECKSUM_START; i < HLW8032_CHECKSUM_INDEX; i++) {
+        sum += buffer[i]; // Wraps modulo 256
     }
-    return (uint8_t)(sum & 0xFF); // Return lower 8 bits
+    return sum;
+}
+
+/**
+ * @brief Checks whether a byte can be the State REG that starts a frame.
+ * @param byte Candidate byte.
+ * @return true for 0x55 (normal), 0xAA (chip error) or 0xFx (overflow flags).
+ */
+static bool HLW8032_IsStateByte(uint8_t byte)
+{
+    return (byte == 0x55) || (byte == 0xAA) || ((byte & 0xF0) == 0xF0);
+}
+
+/**
+ * @brief Reads a 24-bit big-endian register from a frame.
+ * @param frame Pointer to the frame.
+ * @param index Index of the register's first (most significant) byte.
+ * @return Register value.
+ */
+static uint32_t HLW8032_Read24(const uint8_t *frame, uint8_t index)
+{
+    return ((uint32_t)frame[index] << 16) |
+           ((uint32_t)frame[index + 1] << 8) |
+           frame[index + 2];
 }
 
 /**
- * @brief Processes a received HLW8032 packet from the buffer.
- *        Validates checksum and parses data.
+ * @brief Computes num * mul / den in 32-bit arithmetic (no 64-bit division on Cortex-M0+).
+ *        Operands are scaled down together until the product fits; precision loss is
+ *        limited to the dropped low bits of num and den.
+ * @param num Numerator.
+ * @param mul Multiplier.
+ * @param den Denominator.
+ * @return Quotient, or 0 if mul is 0 or den is (or scales to) 0.
+ */
+static uint32_t AC_MulDiv(uint32_t num, uint32_t mul, uint32_t den)
+{
+    if (mul == 0) {
+        return 0;
+    }
+    while (num > (UINT32_MAX / mul)) {
+        num >>= 1;
+        den >>= 1;
+    }
+    if (den == 0) {
+        return 0;
+    }
+    return (num * mul) / den;
+}
+
+/**
+ * @brief Credits PF pulses to the session and lifetime energy totals.
+ *        Energy per pulse follows the datasheet: 1 kWh = 3600 * 10^9 / (Pparam * Kv * Ki) pulses,
+ *        i.e. Pparam * Kp_milli / 3600 nWh per pulse.
+ * @param pulses Number of new PF pulses.
+ * @param p_param Power parameter REG of the frame the pulses came with.
+ */
+static void AC_Energy_Accumulate(uint32_t pulses, uint32_t p_param)
+{
+    uint32_t nwh_per_pulse = AC_MulDiv(p_param, HLW_KP_MILLI, 3600);
+    uint32_t whole_mwh = nwh_per_pulse / AC_NWH_PER_MWH;
+    uint32_t frac_nwh = nwh_per_pulse % AC_NWH_PER_MWH;
+    uint32_t added_mwh = 0;
+
+    while (pulses > 0) {
+        uint32_t chunk = (pulses > AC_ENERGY_CHUNK_PULSES) ? AC_ENERGY_CHUNK_PULSES : pulses;
+        pulses -= chunk;
+
+        ac_energy_nwh += chunk * frac_nwh;
+        added_mwh += chunk * whole_mwh + ac_energy_nwh / AC_NWH_PER_MWH;
+        ac_energy_nwh %= AC_NWH_PER_MWH;
+    }
+
+    if (added_mwh == 0) {
+        return;
+    }
+    ac_session_mwh += added_mwh;
+    added_mwh += ac_lifetime_mwh;
+    ac_lifetime_wh += added_mwh / 1000;
+    ac_lifetime_mwh = (uint16_t)(added_mwh % 1000);
+}
+
+/**
+ * @brief Processes the frame published by the UART ISR, in place.
+ *        Decodes V, I, P from the parameter/register pairs in fixed point, honours the
+ *        State REG overflow flags and the Data update REG, and derives S and PF.
+ *        The frame is handed back to the ISR by clearing hlw8032_packet_ready.
  */
 void AC_Process_HLW8032_Packet(void)
 {
-    // Make a local copy to avoid race conditions if ISR modifies buffer during processing
-    uint8_t local_buffer[HLW8032_PACKET_SIZE];
-    memcpy(local_buffer, hlw8032_rx_packet_buffer, HLW8032_PACKET_SIZE);
+    // Frames with a bad checksum never reach this point; report them here, outside ISR context
+    uint32_t checksum_errors = hlw8032_stats.checksum_errors;
+    if (checksum_errors != hlw8032_checksum_reported) {
+        hlw8032_checksum_reported = checksum_errors;
+        ErrorHandler_Handle(ERROR_HLW_CHECKSUM, "AC_ProcessPacket", __LINE__);
+    }
 
-    // Validate checksum
-    uint8_t received_checksum = local_buffer[HLW8032_CHECKSUM_INDEX];
-    uint8_t calculated_checksum = Calculate_HLW8032_Checksum(local_buffer);
+    if (!hlw8032_packet_ready) {
+        return; // Nothing published
+    }
 
-    if (received_checksum == calculated_checksum) {
-        // Checksum OK - Parse data
-        // Data is typically 24-bit, MSB first
-        uint32_t raw_voltage = ((uint32_t)local_buffer[HLW8032_VOLTAGE_REG_INDEX] << 16) |
-                               ((uint32_t)local_buffer[HLW8032_VOLTAGE_REG_INDEX + 1] << 8) |
-                               local_buffer[HLW8032_VOLTAGE_REG_INDEX + 2];
+    // The ISR does not touch this buffer until hlw8032_packet_ready is cleared, so no copy is needed
+    const uint8_t *frame = hlw8032_frame_buf[hlw8032_ready_index];
+    uint8_t state = frame[HLW8032_STATE_INDEX];
+    uint8_t update = frame[HLW8032_UPDATE_INDEX];
+    uint32_t v_param = HLW8032_Read24(frame, HLW8032_VOLTAGE_PARAM_INDEX);
+    uint32_t v_reg = HLW8032_Read24(frame, HLW8032_VOLTAGE_REG_INDEX);
+    uint32_t i_param = HLW8032_Read24(frame, HLW8032_CURRENT_PARAM_INDEX);
+    uint32_t i_reg = HLW8032_Read24(frame, HLW8032_CURRENT_REG_INDEX);
+    uint32_t p_param = HLW8032_Read24(frame, HLW8032_POWER_PARAM_INDEX);
+    uint32_t p_reg = HLW8032_Read24(frame, HLW8032_POWER_REG_INDEX);
+    uint32_t pf_count = ((uint32_t)frame[HLW8032_PF_INDEX] << 8) | frame[HLW8032_PF_INDEX + 1];
+    if (update & HLW8032_UPDATE_PF_OVF) {
+        pf_count |= 0x10000UL;
+    }
+
+    // Release the buffer as soon as the registers are extracted
+    hlw8032_packet_ready = false;
 
-        uint32_t raw_current = ((uint32_t)local_buffer[HLW8032_CURRENT_REG_INDEX] << 16) |
-                               ((uint32_t)local_buffer[HLW8032_CURRENT_REG_INDEX + 1] << 8) |
-                               local_buffer[HLW8032_CURRENT_REG_INDEX + 2];
+    if (state == HLW8032_STATE_CHIP_ERROR ||
+        (state != HLW8032_STATE_NORMAL && (state & HLW8032_STATE_PARAM_ERROR))) {
+        // Parameter REGs cannot be trusted: keep the last values, report once
+        if (!ac_chip_error_reported) {
+            ac_chip_error_reported = true;
+            ErrorHandler_Handle(ERROR_HLW_FRAME, "AC_ProcessPacket", __LINE__);
+        }
+        return;
+    }
+    ac_chip_error_reported = false;
 
-        uint32_t raw_power = ((uint32_t)local_buffer[HLW8032_POWER_REG_INDEX] << 16) |
-                             ((uint32_t)local_buffer[HLW8032_POWER_REG_INDEX + 1] << 8) |
-                             local_buffer[HLW8032_POWER_REG_INDEX + 2];
+    // Fresh data: restart the age and re-arm the link timeout report
+    ac_last_update_tick = GetTick();
+    ac_data_seen = true;
+    ac_link_timeout_reported = false;
 
-        // TODO: Convert raw values to actual Volts, Amps, Watts using datasheet coefficients
-        // These are placeholders - replace with actual conversion formulas from datasheet!
-        float voltage_coeff = 0.01f; // Example: Replace with actual V/LSB
-        float current_coeff = 0.001f; // Example: Replace with actual A/LSB
-        float power_coeff = 0.01f;   // Example: Replace with actual W/LSB
+    // The PF count is cumulative in the chip, so pulses spanning dropped frames are still credited
+    if (ac_pf_primed) {
+        AC_Energy_Accumulate((pf_count - ac_pf_last) & AC_PF_COUNT_MASK, p_param);
+    }
+    ac_pf_last = pf_count;
+    ac_pf_primed = true;
 
-        ac_rms_voltage = (float)raw_voltage * voltage_coeff;
-        ac_rms_current = (float)raw_current * current_coeff;
-        ac_active_power = (float)raw_power * power_coeff;
+    // 0x55 carries no overflow flags; 0xFx flags a REG whose period ran out (quantity ~0)
+    uint8_t ovf = (state == HLW8032_STATE_NORMAL) ? 0 : (state & (uint8_t)~HLW8032_STATE_OVF_MASK);
 
-        // Optional: Recalculate current from Power and Voltage if needed (e.g., if current reading is less reliable)
-        // if (ac_rms_voltage > 1.0f) { // Avoid division by zero or small voltage
-        //    ac_rms_current = ac_active_power / ac_rms_voltage; // Assumes Power Factor = 1
-        // }
+    if (ovf & HLW8032_STATE_VOLTAGE_OVF) {
+        ac_voltage_mv = 0;
+    } else if (update & HLW8032_UPDATE_VOLTAGE) {
+        ac_voltage_mv = AC_MulDiv(v_param, HLW_KV_MILLI, v_reg);
+    }
 
-        // printf("HLW Packet OK: V=%.2fV, I=%.3fA, P=%.2fW\n", ac_rms_voltage, ac_rms_current, ac_active_power);
+    if (ovf & HLW8032_STATE_CURRENT_OVF) {
+        ac_current_ma = 0;
+    } else if (update & HLW8032_UPDATE_CURRENT) {
+        ac_current_ma = AC_MulDiv(i_param, HLW_KI_MILLI, i_reg);
+    }
 
+    if (ovf & HLW8032_STATE_POWER_OVF) {
+        ac_power_mw = 0;
+    } else if (update & HLW8032_UPDATE_POWER) {
+        ac_power_mw = AC_MulDiv(p_param, HLW_KP_MILLI, p_reg);
+    }
+
+    // Apparent power S = Vrms * Irms; PF = P / S, clamped (P and S come from different REGs)
+    ac_apparent_mva = AC_MulDiv(ac_voltage_mv, ac_current_ma, 1000);
+    if (ac_apparent_mva == 0) {
+        ac_power_factor_pm = 0;
+    } else if (ac_power_mw >= ac_apparent_mva) {
+        ac_power_factor_pm = AC_POWER_FACTOR_ONE;
     } else {
-        // Checksum error - report via handler
-        ErrorHandler_Handle(ERROR_HLW_CHECKSUM, "AC_ProcessPacket", __LINE__);
-        // Optionally clear stored values or keep last known good values
-        // ac_rms_current = 0.0f; // Example: Clear value on error
+        ac_power_factor_pm = (uint16_t)AC_MulDiv(ac_power_mw, AC_POWER_FACTOR_ONE, ac_apparent_mva);
     }
+}
 
-    // Clear the packet ready flag AFTER processing (or attempting to process)
-    hlw8032_packet_ready = false;
+/**
+ * @brief Gets a snapshot of the HLW8032 frame assembler counters.
+ * @param stats Pointer to the structure to fill.
+ */
+void AC_GetFrameStats(AC_FrameStats_t *stats)
+{
+    if (stats == NULL) {
+        return;
+    }
+
+    __disable_irq(); // Enter critical section
+    stats->frames_ok = hlw8032_stats.frames_ok;
+    stats->frames_dropped = hlw8032_stats.frames_dropped;
+    stats->resyncs = hlw8032_stats.resyncs;
+    stats->checksum_errors = hlw8032_stats.checksum_errors;
+    __enable_irq();  // Exit critical section
 }
 
 
@@ -132,7 +338,7 @@ void AC_Process_HLW8032_Packet(void)
 float AC_GetCurrent(void)
 {
     // Returns the latest value updated by AC_Process_HLW8032_Packet
-    return ac_rms_current;
+    return (float)ac_current_ma / 1000.0f;
 }
 
 /**
@@ -142,7 +348,7 @@ float AC_GetCurrent(void)
 float AC_GetVoltage(void)
 {
     // Returns the latest value updated by AC_Process_HLW8032_Packet
-    return ac_rms_voltage;
+    return (float)ac_voltage_mv / 1000.0f;
 }
 
 /**
@@ -152,33 +358,218 @@ float AC_GetVoltage(void)
 float AC_GetPower(void)
 {
      // Returns the latest value updated by AC_Process_HLW8032_Packet
-    return ac_active_power;
+    return (float)ac_power_mw / 1000.0f;
+}
+
+/**
+ * @brief Gets the last calculated RMS voltage.
+ * @return RMS voltage in millivolts.
+ */
+uint32_t AC_GetVoltage_mV(void)
+{
+    return ac_voltage_mv;
+}
+
+/**
+ * @brief Gets the last calculated RMS current.
+ * @return RMS current in milliamperes.
+ */
+uint32_t AC_GetCurrent_mA(void)
+{
+    return ac_current_ma;
+}
+
+/**
+ * @brief Gets the last calculated active power.
+ * @return Active power in milliwatts.
+ */
+uint32_t AC_GetPower_mW(void)
+{
+    return ac_power_mw;
+}
+
+/**
+ * @brief Gets the last calculated apparent power (Vrms * Irms).
+ * @return Apparent power in milli-volt-amperes.
+ */
+uint32_t AC_GetApparentPower_mVA(void)
+{
+    return ac_apparent_mva;
+}
+
+/**
+ * @brief Gets the last calculated power factor (P / S).
+ * @return Power factor in per-mille (0..1000).
+ */
+uint16_t AC_GetPowerFactor_Permille(void)
+{
+    return ac_power_factor_pm;
+}
+
+/**
+ * @brief Gets the age of the last decoded HLW8032 frame.
+ * @return Milliseconds since the last frame (since init if none has arrived yet).
+ */
+uint32_t AC_GetDataAge_ms(void)
+{
+    return GetTick() - ac_last_update_tick;
+}
+
+/**
+ * @brief Checks whether the V/I/P values are fresh enough to act on.
+ * @return true if a frame was decoded within HLW_STALE_TIMEOUT_MS.
+ */
+bool AC_IsDataValid(void)
+{
+    return ac_data_seen && (AC_GetDataAge_ms() <= HLW_STALE_TIMEOUT_MS);
+}
+
+/**
+ * @brief Discards a partly received HLW8032 frame and hunts for the next header.
+ */
+void AC_Measurement_Resync(void)
+{
+    __disable_irq(); // Enter critical section (assembler state is ISR-owned)
+    hlw8032_rx_byte_count = 0;
+    hlw8032_in_sync = false;
+    __enable_irq();  // Exit critical section
+}
+
+/**
+ * @brief Checks the HLW8032 link for a timeout.
+ *        Reports ERROR_HLW_UART_TIMEOUT once per outage when no frame was decoded
+ *        within HLW_LINK_TIMEOUT_MS.
+ * @return true if the link is alive, false on timeout.
+ */
+bool AC_Measurement_CheckLink(void)
+{
+    if (AC_GetDataAge_ms() <= HLW_LINK_TIMEOUT_MS) {
+        return true;
+    }
+    if (!ac_link_timeout_reported) {
+        ac_link_timeout_reported = true;
+        ErrorHandler_Handle(ERROR_HLW_UART_TIMEOUT, "AC_CheckLink", __LINE__);
+    }
+    return false;
+}
+
+/**
+ * @brief Starts a new charging session: the session energy total restarts from 0.
+ */
+void AC_Energy_StartSession(void)
+{
+    ac_session_mwh = 0;
+    ac_session_count++;
+}
+
+/**
+ * @brief Gets the energy delivered in the current session.
+ * @return Session energy in milliwatt-hours.
+ */
+uint32_t AC_Energy_GetSession_mWh(void)
+{
+    return ac_session_mwh;
+}
+
+/**
+ * @brief Gets the energy delivered in the current session.
+ * @return Session energy in watt-hours (truncated).
+ */
+uint32_t AC_Energy_GetSession_Wh(void)
+{
+    return ac_session_mwh / 1000;
+}
+
+/**
+ * @brief Gets the lifetime energy total.
+ * @return Lifetime energy in watt-hours (truncated).
+ */
+uint32_t AC_Energy_GetLifetime_Wh(void)
+{
+    return ac_lifetime_wh;
+}
+
+/**
+ * @brief Gets the number of sessions started.
+ * @return Session count (wraps at 65535).
+ */
+uint16_t AC_Energy_GetSessionCount(void)
+{
+    return ac_session_count;
+}
+
+/**
+ * @brief Restores the persistent energy counters (e.g. from the flash journal).
+ * @param lifetime_wh Lifetime energy in watt-hours.
+ * @param session_count Number of sessions started.
+ */
+void AC_Energy_Restore(uint32_t lifetime_wh, uint16_t session_count)
+{
+    ac_lifetime_wh = lifetime_wh;
+    ac_lifetime_mwh = 0;
+    ac_session_count = session_count;
 }
 
 // --- Internal ISR Helper ---
 /**
- * @brief Stores a received byte from HLW8032 UART ISR.
- *        Sets packet ready flag when 24 bytes are received.
+ * @brief Assembles the HLW8032 byte stream into frames (called from the UART2 ISR).
+ *        Syncs on State REG + 0x5A, writes bytes directly into the fill buffer and
+ *        publishes a checksum-valid frame by flipping buffers.
  * @param byte The received byte.
  */
 void AC_Store_HLW8032_Byte(uint8_t byte)
 {
-    // This function is likely called from the UART2 ISR context via HLW_UART_Handle_RC
-    // It should be kept very simple.
+    uint8_t *frame = hlw8032_frame_buf[hlw8032_fill_index];
 
-    if (hlw8032_rx_byte_count < HLW8032_PACKET_SIZE) {
-        hlw8032_rx_packet_buffer[hlw8032_rx_byte_count++] = byte;
-        if (hlw8032_rx_byte_count >= HLW8032_PACKET_SIZE) {
-            // Only set the flag if a full packet is received
-            hlw8032_packet_ready = true; // Signal main loop to process
-            hlw8032_rx_byte_count = 0;   // Reset for next packet
+    if (hlw8032_rx_byte_count == HLW8032_STATE_INDEX) {
+        if (!HLW8032_IsStateByte(byte)) {
+            // Not a frame start: hunt, counting one resync per loss of sync
+            if (hlw8032_in_sync) {
+                hlw8032_in_sync = false;
+                hlw8032_stats.resyncs++;
+            }
+            return;
         }
-        // If count < PACKET_SIZE, do nothing, wait for more bytes
-    } else {
-        // Should not happen if logic is correct, but as a safeguard:
-        // Buffer overflow or synchronization issue, reset count.
-        hlw8032_rx_byte_count = 0;
-        // Consider reporting a framing error?
-        // ErrorHandler_Handle(ERROR_HLW_FRAME, "AC_StoreByte", __LINE__); // Be cautious calling handler from ISR context
+        frame[hlw8032_rx_byte_count++] = byte;
+        return;
+    }
+
+    if (hlw8032_rx_byte_count == HLW8032_CHECK_INDEX && byte != HLW8032_CHECK_BYTE) {
+        // False header; this byte may itself start the real frame
+        if (hlw8032_in_sync) {
+            hlw8032_in_sync = false;
+            hlw8032_stats.resyncs++;
+        }
+        if (HLW8032_IsStateByte(byte)) {
+            frame[HLW8032_STATE_INDEX] = byte;
+        } else {
+            hlw8032_rx_byte_count = 0;
+        }
+        return;
     }
+
+    frame[hlw8032_rx_byte_count++] = byte;
+    if (hlw8032_rx_byte_count < HLW8032_PACKET_SIZE) {
+        return; // Wait for more bytes
+    }
+    hlw8032_rx_byte_count = 0;
+
+    if (Calculate_HLW8032_Checksum(frame) != frame[HLW8032_CHECKSUM_INDEX]) {
+        // Reuse the fill buffer; reported from main context by AC_Process_HLW8032_Packet
+        hlw8032_stats.checksum_errors++;
+        hlw8032_in_sync = false;
+        return;
+    }
+    hlw8032_in_sync = true;
+
+    if (hlw8032_packet_ready) {
+        // Main loop still owns the other buffer; overwrite this one with the next frame
+        hlw8032_stats.frames_dropped++;
+        return;
+    }
+
+    hlw8032_ready_index = hlw8032_fill_index;
+    hlw8032_fill_index ^= 1;
+    hlw8032_stats.frames_ok++;
+    hlw8032_packet_ready = true; // Signal main loop to process
 }
@@ -3,21 +3,113 @@
 #include "cw32f003_rcc.h"  // Include RCC for clock enabling
 #include "cw32f003_gpio.h" // Include GPIO for pin configuration
 #include "cw32f003_adc.h"  // Include ADC peripheral driver
+#include "cw32f003_atim.h" // For the ATIM compare flags used by PWM synchronised sampling
+#include "config.h"        // For CP_SYNC_* trigger assignments
 #include "error_handler.h" // Include the error handler
-#include <stdio.h>         // For printf debugging
+#include "uart_driver.h"    // For the start-up message
+#include "temp_sensor.h"    // Fixed-point temperature conversion
 #include <math.h>          // Include for potential float operations (though likely not strictly needed for this formula)
 
 /* FLASH Calibration Value Addresses */
 #define CAL_T0_ADDRESS      (0x001007C5UL) // 8-bit T0 value (unit: 0.5 deg C)
 #define CAL_TRIM1V5_ADDRESS (0x001007C6UL) // 16-bit Trim value for 1.5V ref
 
-#define VOLTAGE_AVG_SAMPLES 8 // Number of samples to average for voltage reading
+#define VOLTAGE_AVG_LOG2 3 // Samples averaged for voltage reading: 2^3 = 8, one hardware burst
 
 // Define a reasonable timeout count for ADC conversion wait loop
 // Adjust based on clock speed, sample time, and expected conversion time.
 // Example: If conversion takes ~1us, 10000 loops is ~10ms timeout.
 #define ADC_CONVERSION_TIMEOUT 10000
 
+// Number of 1ms trigger ticks a scan may stay busy before it is restarted
+#define ADC_SCAN_TIMEOUT_TICKS 5
+
+// Wait loops covering one main sequence (2 conversions at PCLK/32, ~25us), for a sequence
+// an ATIM trigger started just before the trigger was removed
+#define ADC_SCAN_DRAIN_COUNT 400
+
+#define ADC_NO_RESULT 0xFFFF // Value returned for slots that have not been converted yet
+
+// VDD tracking: VDD/3 converted against the 1.5V bandgap -> VDD_mV = raw * 4500 / 4095
+#define ADC_VDDDIV3_FULL_SCALE_MV 4500
+#define ADC_VDD_MIN_PLAUSIBLE_MV  1650 // Below the device minimum supply
+#define ADC_VDD_MAX_PLAUSIBLE_MV  4400 // VDD/3 close to the 1.5V full scale saturates
+
+// --- Background Scan Engine State ---
+typedef enum {
+    ADC_SCAN_PHASE_MAIN = 0, // CP, PP against VDD
+    ADC_SCAN_PHASE_REF,      // Temperature, VDD/3 against the 1.5V reference
+    ADC_SCAN_PHASE_BURST     // Accumulated single channel burst (oversampling job)
+} ADC_ScanPhase_t;
+
+static volatile bool scan_running = false;
+static volatile bool scan_busy = false;             // A sequence is converting
+static volatile ADC_ScanPhase_t scan_phase = ADC_SCAN_PHASE_MAIN;
+static volatile uint32_t scan_count = 0;            // Completed main sequences
+static uint16_t scan_ref_countdown = 0;             // Main scans left until the next reference pass
+static uint8_t scan_busy_ticks = 0;                 // Trigger ticks spent waiting for EOS
+static volatile bool scan_pwm_sync = false;         // Main sequence started by ATIM compare events
+static uint8_t scan_idle_ticks = 0;                 // Ticks without a completed scan (sync mode)
+
+// Result cache: latest value plus a running sum over the last ADC_SCAN_AVG_SAMPLES results
+static volatile uint16_t scan_latest[ADC_SCAN_SLOT_COUNT];
+static volatile uint32_t scan_sum[ADC_SCAN_SLOT_COUNT];
+static uint16_t scan_history[ADC_SCAN_SLOT_COUNT][ADC_SCAN_AVG_SAMPLES];
+static uint8_t scan_history_index[ADC_SCAN_SLOT_COUNT];
+static volatile bool scan_slot_valid[ADC_SCAN_SLOT_COUNT];
+static volatile uint32_t scan_slot_count[ADC_SCAN_SLOT_COUNT];
+static ADC_Filter_t * volatile scan_filter[ADC_SCAN_SLOT_COUNT]; // Optional per-slot filter pipeline
+static bool scan_filter_vdd_comp[ADC_SCAN_SLOT_COUNT];          // Feed the filter VDD compensated samples
+
+// --- Oversampling Job State ---
+static volatile bool burst_pending = false;         // Job waits for the current scan sequence
+static volatile bool burst_active = false;          // Job queued or converting
+static volatile bool burst_done = false;            // Result ready, not collected yet
+static uint32_t burst_channel = 0;
+static uint8_t burst_log2 = 0;
+static volatile uint16_t burst_result = 0;
+static volatile uint32_t burst_acc = 0;             // Raw RESULTACC sum of the last burst
+
+// --- Temperature Calibration Cache (loaded once from flash) ---
+static bool temp_cal_loaded = false;
+static int32_t temp_offset_cc_q10 = 0;              // (T0 * 50 - 13.86 * Trim) in Q10 centi-degrees
+
+// --- VDD Tracking State (updated by the reference pass, Q12 factors) ---
+static volatile uint16_t vdd_mv = ADC_REFERENCE_VOLTAGE_MV;
+static volatile uint16_t vdd_comp_q12 = ADC_VDD_Q12_ONE;   // VDD_actual / VDD_nominal
+static volatile uint16_t vdd_uncomp_q12 = ADC_VDD_Q12_ONE; // VDD_nominal / VDD_actual
+
+// --- CP Window Watch State ---
+static volatile bool cp_watch_armed = false;        // Analog watchdog band programmed on CP
+static volatile bool cp_watch_event = false;        // A CP sample left the band since arming
+
+/**
+ * @brief Reads the factory temperature calibration once and folds it into a Q10 offset.
+ */
+static void ADC_Temperature_LoadCalibration(void)
+{
+    uint8_t t0_cal = *(volatile uint8_t*)CAL_T0_ADDRESS;        // Unit: 0.5 deg C
+    uint16_t trim_cal = *(volatile uint16_t*)CAL_TRIM1V5_ADDRESS; // 1.5V reference trim
+
+    temp_offset_cc_q10 = TempSensor_CalOffset(t0_cal, trim_cal);
+    temp_cal_loaded = true;
+}
+
+/**
+ * @brief Converts a raw temperature sensor result (1.5V reference) to centi-degrees.
+ *        One multiply, one add and one shift; no floating point.
+ * @param raw Raw 12-bit result.
+ * @return Temperature in 0.01 deg C, saturated to the int16_t range.
+ */
+static int16_t ADC_Temperature_RawToCentiC(uint16_t raw)
+{
+    if (!temp_cal_loaded) {
+        ADC_Temperature_LoadCalibration();
+    }
+    // Never returns INT16_MIN, which is reserved for ADC_TEMPERATURE_INVALID
+    return TempSensor_RawToCentiC(temp_offset_cc_q10, raw);
+}
+
 /**
  * @brief Initializes the ADC peripheral for single channel conversion on PA01.
  * @param None
@@ -62,10 +154,795 @@ bool ADC_Driver_Init(void)
     /* Enable ADC */
     ADC_Enable();
 
-    printf("ADC Driver Initialized (PA01/CH1, PA04/CH2)\r\n"); // Updated message
+    // Factory calibration never changes; read it once instead of on every temperature request
+    ADC_Temperature_LoadCalibration();
+
+    UART_WriteString("ADC Driver Initialized (PA01/CH1, PA04/CH2)\r\n"); // Updated message
     return true; // Assuming initialization is always successful for now
 }
 
+// --- Background Scan Engine Helpers ---
+
+/**
+ * @brief Configures the ADC for the main scan sequence (SQR0 = CP, SQR1 = PP, VDD reference).
+ */
+static void ADC_Scan_ConfigMain(void)
+{
+    ADC_SerialChTypeDef ADC_SerialChStructure;
+
+    ADC_SerialChStructure.ADC_SqrEns = ADC_SqrEns01;
+    ADC_SerialChStructure.ADC_Sqr0Chmux = ADC_SqrCh1;  // CP (PA01)
+    ADC_SerialChStructure.ADC_Sqr1Chmux = ADC_SqrCh2;  // PP (PA04)
+    ADC_SerialChStructure.ADC_Sqr2Chmux = ADC_SqrCh1;  // Unused
+    ADC_SerialChStructure.ADC_Sqr3Chmux = ADC_SqrCh1;  // Unused
+    ADC_SerialChStructure.ADC_InitStruct.ADC_OpMode = ADC_SerialChScanMode;
+    ADC_SerialChStructure.ADC_InitStruct.ADC_ClkDiv = ADC_Clk_Div32;
+    ADC_SerialChStructure.ADC_InitStruct.ADC_SampleTime = ADC_SampTime5Clk;
+    ADC_SerialChStructure.ADC_InitStruct.ADC_VrefSel = ADC_Vref_VDD;
+    ADC_SerialChStructure.ADC_InitStruct.ADC_InBufEn = ADC_BufDisable;
+    ADC_SerialChStructure.ADC_InitStruct.ADC_TsEn = ADC_TsDisable;
+    ADC_SerialChStructure.ADC_InitStruct.ADC_Align = ADC_AlignRight;
+    ADC_SerialChStructure.ADC_InitStruct.ADC_AccEn = ADC_AccDisable;
+
+    ADC_SerialChScanModeCfg(&ADC_SerialChStructure);
+}
+
+/**
+ * @brief Configures the ADC for the reference pass (1.5V reference, input buffer on).
+ *        SQR0 is a settling conversion after the reference switch and is discarded.
+ */
+static void ADC_Scan_ConfigRefPass(void)
+{
+    ADC_SerialChTypeDef ADC_SerialChStructure;
+
+    ADC_SerialChStructure.ADC_SqrEns = ADC_SqrEns02;
+    ADC_SerialChStructure.ADC_Sqr0Chmux = ADC_SqrTs;       // Settling, discarded
+    ADC_SerialChStructure.ADC_Sqr1Chmux = ADC_SqrTs;       // Temperature sensor
+    ADC_SerialChStructure.ADC_Sqr2Chmux = ADC_SqrVddDiv3;  // VDD / 3
+    ADC_SerialChStructure.ADC_Sqr3Chmux = ADC_SqrTs;       // Unused
+    ADC_SerialChStructure.ADC_InitStruct.ADC_OpMode = ADC_SerialChScanMode;
+    ADC_SerialChStructure.ADC_InitStruct.ADC_ClkDiv = ADC_Clk_Div32;
+    ADC_SerialChStructure.ADC_InitStruct.ADC_SampleTime = ADC_SampTime10Clk;
+    ADC_SerialChStructure.ADC_InitStruct.ADC_VrefSel = ADC_Vref_BGR1p5;
+    ADC_SerialChStructure.ADC_InitStruct.ADC_InBufEn = ADC_BufEnable;
+    ADC_SerialChStructure.ADC_InitStruct.ADC_TsEn = ADC_TsEnable;
+    ADC_SerialChStructure.ADC_InitStruct.ADC_Align = ADC_AlignRight;
+    ADC_SerialChStructure.ADC_InitStruct.ADC_AccEn = ADC_AccDisable;
+
+    ADC_SerialChScanModeCfg(&ADC_SerialChStructure);
+}
+
+/**
+ * @brief Stores a result in the cache and updates the slot's running sum.
+ *        Called from ADC interrupt context only.
+ * @param slot The result slot.
+ * @param value Raw 12-bit result.
+ */
+static void ADC_Scan_Store(ADC_ScanSlot_t slot, uint16_t value)
+{
+    uint8_t i;
+
+    if (!scan_slot_valid[slot]) {
+        // Seed the history so the first average is not pulled towards zero
+        for (i = 0; i < ADC_SCAN_AVG_SAMPLES; i++) {
+            scan_history[slot][i] = value;
+        }
+        scan_sum[slot] = (uint32_t)value * ADC_SCAN_AVG_SAMPLES;
+        scan_slot_valid[slot] = true;
+    } else {
+        i = scan_history_index[slot];
+        scan_sum[slot] = scan_sum[slot] - scan_history[slot][i] + value;
+        scan_history[slot][i] = value;
+        scan_history_index[slot] = (uint8_t)((i + 1) & (ADC_SCAN_AVG_SAMPLES - 1));
+    }
+    scan_latest[slot] = value;
+    scan_slot_count[slot]++;
+
+    if (scan_filter[slot] != NULL) {
+        ADC_Filter_Update(scan_filter[slot], scan_filter_vdd_comp[slot] ? ADC_Vdd_Compensate(value) : value);
+    }
+}
+
+/**
+ * @brief Stores the CP result of a main scan in the slot matching the PWM phase.
+ *        The ATIM compare flag that fired the scan tells which plateau was sampled.
+ *        Called from ADC interrupt context only.
+ * @param value Raw 12-bit CP result.
+ * @return The slot the result was stored in, or ADC_SCAN_SLOT_COUNT if it was dropped.
+ */
+static ADC_ScanSlot_t ADC_Scan_StoreCp(uint16_t value)
+{
+    bool high_event, low_event;
+    uint32_t triggers;
+
+    if (!scan_pwm_sync) {
+        ADC_Scan_Store(ADC_SCAN_SLOT_CP, value);
+        return ADC_SCAN_SLOT_CP;
+    }
+
+    // A compare whose ADC trigger is disabled (0% / 100% duty) still sets its flag every
+    // period; only flags of enabled triggers say which plateau started the scan
+    triggers = CW_ATIM->TRIG;
+    high_event = (triggers & CP_SYNC_HIGH_TRIGGER) && (ATIM_GetITStatus(CP_SYNC_HIGH_FLAG) != RESET);
+    low_event = (triggers & CP_SYNC_LOW_TRIGGER) && (ATIM_GetITStatus(CP_SYNC_LOW_FLAG) != RESET);
+    ATIM_ClearITPendingBit(CP_SYNC_HIGH_FLAG | CP_SYNC_LOW_FLAG);
+
+    if (high_event && low_event) {
+        return ADC_SCAN_SLOT_COUNT; // Phase is ambiguous (a scan was missed), drop this CP sample
+    } else if (low_event) {
+        ADC_Scan_Store(ADC_SCAN_SLOT_CP_LOW, value);
+        return ADC_SCAN_SLOT_CP_LOW;
+    }
+    // High plateau trigger, or a SysTick fallback kick while the PWM is stopped (DC level)
+    ADC_Scan_Store(ADC_SCAN_SLOT_CP, value);
+    return ADC_SCAN_SLOT_CP;
+}
+
+/**
+ * @brief Recomputes the VDD estimate and the Q12 correction factors from the VDD/3 average.
+ *        Two divisions every ADC_SCAN_REF_PASS_INTERVAL scans; readers only multiply and shift.
+ *        Called from ADC interrupt context only.
+ */
+static void ADC_Vdd_Update(void)
+{
+    uint32_t mv = ((uint32_t)(scan_sum[ADC_SCAN_SLOT_VDD] / ADC_SCAN_AVG_SAMPLES) * ADC_VDDDIV3_FULL_SCALE_MV) / 4095;
+
+    if (mv < ADC_VDD_MIN_PLAUSIBLE_MV || mv > ADC_VDD_MAX_PLAUSIBLE_MV) {
+        return; // Keep the last good estimate (nominal until the first one)
+    }
+    vdd_mv = (uint16_t)mv;
+    vdd_comp_q12 = (uint16_t)((mv * ADC_VDD_Q12_ONE + ADC_REFERENCE_VOLTAGE_MV / 2) / ADC_REFERENCE_VOLTAGE_MV);
+    vdd_uncomp_q12 = (uint16_t)(((uint32_t)ADC_REFERENCE_VOLTAGE_MV * ADC_VDD_Q12_ONE + mv / 2) / mv);
+}
+
+/**
+ * @brief Maps an ADC input channel to the scan slot that caches it.
+ * @param channel ADC input channel (e.g., ADC_ExInputCH1).
+ * @param slot Pointer to store the slot.
+ * @return true if the channel is cached by the main scan sequence.
+ */
+static bool ADC_Scan_ChannelToSlot(uint32_t channel, ADC_ScanSlot_t *slot)
+{
+    if (channel == ADC_ExInputCH1) {
+        *slot = ADC_SCAN_SLOT_CP;
+        return true;
+    } else if (channel == ADC_ExInputCH2) {
+        *slot = ADC_SCAN_SLOT_PP;
+        return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Reconfigures the ADC for an accumulated burst and starts it.
+ *        Caller must own the ADC (no sequence converting, scan_busy set).
+ *        Only EOA interrupts the CPU; the 2^burst_log2 conversions sum up in RESULTACC.
+ */
+static void ADC_Burst_Launch(void)
+{
+    ADC_SingleChTypeDef ADC_SingleChStructure;
+
+    if (scan_pwm_sync) {
+        ADC_ExtTrigCfg(ADC_TRIG_ATIM, DISABLE); // Keep PWM triggers out of the burst
+    }
+
+    ADC_SingleChStructure.ADC_Chmux = burst_channel;
+    ADC_SingleChStructure.ADC_DiscardEn = ADC_DiscardNull;
+    ADC_SingleChStructure.ADC_InitStruct.ADC_OpMode = ADC_SingleChMoreMode;
+    ADC_SingleChStructure.ADC_InitStruct.ADC_ClkDiv = ADC_Clk_Div32;
+    ADC_SingleChStructure.ADC_InitStruct.ADC_SampleTime = ADC_SampTime5Clk;
+    ADC_SingleChStructure.ADC_InitStruct.ADC_VrefSel = ADC_Vref_VDD;
+    ADC_SingleChStructure.ADC_InitStruct.ADC_InBufEn = ADC_BufDisable;
+    ADC_SingleChStructure.ADC_InitStruct.ADC_TsEn = ADC_TsDisable;
+    ADC_SingleChStructure.ADC_InitStruct.ADC_Align = ADC_AlignRight;
+    ADC_SingleChStructure.ADC_InitStruct.ADC_AccEn = ADC_AccEnable; // Forced by ADC_SingleChMoreModeCfg as well
+    ADC_WdtInit(&ADC_SingleChStructure.ADC_WdtStruct);
+
+    // CNT holds the number of conversions minus one
+    ADC_SingleChMoreModeCfg(&ADC_SingleChStructure, (uint8_t)((1UL << burst_log2) - 1));
+    ADC_ClrAccResult();
+
+    ADC_ITConfig(ADC_IT_EOS, DISABLE);
+    ADC_ClearITPendingAll();
+    ADC_ITConfig(ADC_IT_EOA, ENABLE);
+
+    burst_pending = false;
+    scan_phase = ADC_SCAN_PHASE_BURST;
+    scan_busy = true;
+    ADC_SoftwareStartConvCmd(ENABLE);
+}
+
+/**
+ * @brief Decimates an accumulated burst: 4^n samples give n extra bits.
+ * @param acc Sum of 2^log2_samples 12-bit results.
+ * @param log2_samples Burst length as a power of two.
+ * @return Rounded result with 12 + log2_samples/2 bits.
+ */
+static uint16_t ADC_Burst_Decimate(uint32_t acc, uint8_t log2_samples)
+{
+    uint8_t shift = (uint8_t)(log2_samples - log2_samples / 2); // Drop the bits noise cannot resolve
+
+    if (shift == 0) {
+        return (uint16_t)acc;
+    }
+    return (uint16_t)((acc + (1UL << (shift - 1))) >> shift);
+}
+
+/**
+ * @brief Hands the ADC back to the main scan sequence after a reference pass or a burst.
+ *        Called from ADC interrupt context, or from SysTick (higher priority) on recovery.
+ */
+static void ADC_Scan_Resume(void)
+{
+    ADC_Scan_ConfigMain();
+    scan_phase = ADC_SCAN_PHASE_MAIN;
+    if (scan_running) {
+        ADC_ITConfig(ADC_IT_EOS, ENABLE);
+        if (scan_pwm_sync) {
+            // Compare flags raised meanwhile belong to skipped triggers
+            ATIM_ClearITPendingBit(CP_SYNC_HIGH_FLAG | CP_SYNC_LOW_FLAG);
+            ADC_ExtTrigCfg(ADC_TRIG_ATIM, ENABLE);
+        }
+    }
+    scan_busy = false;
+}
+
+/**
+ * @brief Checks whether a sequence is converting, including one started by an ATIM
+ *        trigger (those never pass through software, but set START while they run).
+ */
+static bool ADC_Scan_Converting(void)
+{
+    return scan_busy || ((CW_ADC->START & ADC_START_START_Msk) != 0);
+}
+
+/**
+ * @brief Recovers from a lost end-of-sequence / end-of-accumulation interrupt.
+ *        A main sequence is simply restarted. A reference pass or burst is dropped and the
+ *        ADC handed back to the main scan, which re-enables the ATIM trigger it disabled;
+ *        restarting it instead could leave the trigger off for good if the end is lost again.
+ *        Called from SysTick_Handler (pre-empts the ADC interrupt).
+ */
+static void ADC_Scan_Recover(void)
+{
+    if (scan_phase == ADC_SCAN_PHASE_MAIN) {
+        ADC_SoftwareStartConvCmd(ENABLE);
+        return;
+    }
+
+    ADC_SoftwareStartConvCmd(DISABLE);
+    if (scan_phase == ADC_SCAN_PHASE_BURST) {
+        ADC_ITConfig(ADC_IT_EOA, DISABLE);
+        ADC_ClrAccResult();
+        burst_active = false; // Job dropped: the waiter times out with ADC_NO_RESULT
+    }
+    ADC_ClearITPendingAll();
+    ADC_Scan_Resume();
+}
+
+// --- Background Scan Engine ---
+
+/**
+ * @brief Starts the background scan engine.
+ * @return true if the engine is running.
+ */
+bool ADC_Scan_Start(void)
+{
+    if (scan_running) {
+        return true;
+    }
+
+    RCC_APBPeriphClk_Enable2(RCC_APB2_PERIPH_ADC, ENABLE);
+    ADC_Enable();
+
+    if (scan_busy) {
+        // An oversampling burst owns the ADC; the ISR hands it to the scan when done
+        scan_ref_countdown = 0;
+        scan_running = true;
+        return true;
+    }
+
+    ADC_Scan_ConfigMain();
+    scan_phase = ADC_SCAN_PHASE_MAIN;
+    scan_ref_countdown = 0; // Run a reference pass right after the first scan
+    scan_busy_ticks = 0;
+    scan_busy = false;
+
+    ADC_ClearITPendingAll();
+    ADC_ITConfig(ADC_IT_EOS, ENABLE);
+    ADC_EnableIrq(ADC_SCAN_IRQ_PRIORITY);
+
+    scan_running = true;
+    if (scan_pwm_sync) {
+        ATIM_ClearITPendingBit(CP_SYNC_HIGH_FLAG | CP_SYNC_LOW_FLAG);
+        ADC_ExtTrigCfg(ADC_TRIG_ATIM, ENABLE);
+    }
+    return true;
+}
+
+/**
+ * @brief Stops the background scan engine.
+ */
+void ADC_Scan_Stop(void)
+{
+    volatile uint32_t timeout_counter = ADC_CONVERSION_TIMEOUT;
+    volatile uint32_t drain = ADC_SCAN_DRAIN_COUNT;
+
+    scan_running = false; // No new sequences are triggered from here on
+    ADC_ExtTrigCfg(ADC_TRIG_ATIM, DISABLE);
+    while (drain-- != 0) {
+        // A trigger just before the disable may have started a sequence not yet visible
+    }
+
+    // A queued burst no longer has a scan sequence to follow; start it now
+    __disable_irq(); // Enter critical section
+    if (burst_pending && !scan_busy) {
+        ADC_Burst_Launch();
+    }
+    __enable_irq();  // Exit critical section
+
+    // Let a running sequence (including a reference pass, burst or ATIM-started scan) finish
+    while (ADC_Scan_Converting()) {
+        if (timeout_counter-- == 0) {
+            ErrorHandler_Handle(ERROR_TIMEOUT, "ADC_Scan_Stop", __LINE__);
+            break;
+        }
+    }
+
+    ADC_ITConfig(ADC_IT_EOS, DISABLE);
+    ADC_ClearITPendingAll();
+    scan_busy = false;
+    cp_watch_armed = false; // No more CP samples are checked against the band
+}
+
+/**
+ * @brief Checks whether the background scan engine is running.
+ * @return true if running.
+ */
+bool ADC_Scan_IsRunning(void)
+{
+    return scan_running;
+}
+
+/**
+ * @brief Starts the next main scan sequence if the previous one has completed.
+ *        Called from SysTick_Handler (1ms).
+ */
+void ADC_Scan_Trigger(void)
+{
+    if (!scan_running) {
+        return;
+    }
+
+    if (scan_busy) {
+        // A lost EOS/EOA would stall the cache, and in PWM-sync mode leave the ATIM trigger
+        // disabled by a reference pass or burst; recover after a few ticks
+        if (++scan_busy_ticks >= ADC_SCAN_TIMEOUT_TICKS) {
+            scan_busy_ticks = 0;
+            ADC_Scan_Recover();
+        }
+        return;
+    }
+    scan_busy_ticks = 0;
+
+    if (scan_pwm_sync) {
+        // ATIM starts the scans; only step in if the PWM stopped producing triggers
+        if (++scan_idle_ticks < ADC_SCAN_TIMEOUT_TICKS) {
+            return;
+        }
+        scan_idle_ticks = 0;
+    }
+
+    scan_busy = true;
+    ADC_SoftwareStartConvCmd(ENABLE);
+}
+
+/**
+ * @brief Gets the latest raw result of a scan slot.
+ * @param slot The result slot.
+ * @return Raw 12-bit result, or 0xFFFF if the slot has not been converted yet.
+ */
+uint16_t ADC_Scan_GetRaw(ADC_ScanSlot_t slot)
+{
+    if (slot >= ADC_SCAN_SLOT_COUNT || !scan_slot_valid[slot]) {
+        return ADC_NO_RESULT;
+    }
+    return scan_latest[slot];
+}
+
+/**
+ * @brief Gets the mean of the last ADC_SCAN_AVG_SAMPLES results of a scan slot.
+ * @param slot The result slot.
+ * @return Averaged raw 12-bit result, or 0xFFFF if the slot has not been converted yet.
+ */
+uint16_t ADC_Scan_GetAverage(ADC_ScanSlot_t slot)
+{
+    if (slot >= ADC_SCAN_SLOT_COUNT || !scan_slot_valid[slot]) {
+        return ADC_NO_RESULT;
+    }
+    // Single 32-bit read of the running sum; the ISR keeps it consistent
+    return (uint16_t)(scan_sum[slot] / ADC_SCAN_AVG_SAMPLES);
+}
+
+/**
+ * @brief Gets the number of results stored in a slot since ADC_Scan_Start().
+ * @param slot The result slot.
+ * @return Sample count (wraps).
+ */
+uint32_t ADC_Scan_GetSampleCount(ADC_ScanSlot_t slot)
+{
+    if (slot >= ADC_SCAN_SLOT_COUNT) {
+        return 0;
+    }
+    return scan_slot_count[slot];
+}
+
+/**
+ * @brief Attaches a filter pipeline to a scan slot; every new result is fed to it from the ISR.
+ * @param slot The result slot.
+ * @param filter Initialized filter (static storage), or NULL to detach.
+ * @param vdd_compensate true to feed ADC_Vdd_Compensate()d samples (signals not referenced to VDD).
+ */
+void ADC_Scan_AttachFilter(ADC_ScanSlot_t slot, ADC_Filter_t *filter, bool vdd_compensate)
+{
+    if (slot >= ADC_SCAN_SLOT_COUNT) {
+        ErrorHandler_Handle(ERROR_INVALID_PARAM, "ADC_Scan_AttachFilter", __LINE__);
+        return;
+    }
+
+    scan_filter[slot] = NULL; // Detach first so the ISR never sees a half-updated pairing
+    scan_filter_vdd_comp[slot] = vdd_compensate;
+    scan_filter[slot] = filter;
+}
+
+/**
+ * @brief Switches the CP/PP scan between SysTick kicks and ATIM (PWM) triggers.
+ * @param enable true for PWM synchronised sampling.
+ */
+void ADC_Scan_SetPwmSync(bool enable)
+{
+    if (enable == scan_pwm_sync) {
+        return;
+    }
+
+    if (!enable) {
+        ADC_ExtTrigCfg(ADC_TRIG_ATIM, DISABLE);
+        scan_pwm_sync = false;
+        return;
+    }
+
+    scan_idle_ticks = 0;
+    ATIM_ClearITPendingBit(CP_SYNC_HIGH_FLAG | CP_SYNC_LOW_FLAG);
+    scan_pwm_sync = true;
+    // While a reference pass runs the ISR re-enables the trigger when it completes
+    if (scan_running && !(scan_busy && scan_phase == ADC_SCAN_PHASE_REF)) {
+        ADC_ExtTrigCfg(ADC_TRIG_ATIM, ENABLE);
+    }
+}
+
+/**
+ * @brief Gets the number of completed CP/PP scans since ADC_Scan_Start().
+ * @return Completed scan count (wraps).
+ */
+uint32_t ADC_Scan_GetCount(void)
+{
+    return scan_count;
+}
+
+/**
+ * @brief Internal function to handle ADC interrupts (End Of Sequence).
+ *        Should be called from ADC_IRQHandler.
+ */
+void ADC_Driver_Handle_IRQ(void)
+{
+    uint16_t result;
+    uint32_t acc;
+    ADC_ScanSlot_t cp_slot;
+    bool cp_out_of_band;
+
+    if (scan_phase == ADC_SCAN_PHASE_BURST) {
+        if (ADC_GetITStatus(ADC_IT_EOA) == RESET) {
+            return;
+        }
+        ADC_GetAccResult(&acc);
+        ADC_ClrAccResult();
+        ADC_ITConfig(ADC_IT_EOA, DISABLE);
+        ADC_ClearITPendingAll(); // Also drops the per-conversion EOC/EOS flags of the burst
+
+        burst_acc = acc;
+        burst_result = ADC_Burst_Decimate(acc, burst_log2);
+        burst_done = true;
+        ADC_Scan_Resume();
+        return;
+    }
+
+    if (ADC_GetITStatus(ADC_IT_EOS) == RESET) {
+        return;
+    }
+    ADC_ClearITPendingBit(ADC_IT_EOS);
+
+    if (scan_phase == ADC_SCAN_PHASE_MAIN) {
+        // Window flags of the CP conversion (SQR0); the watchdog only monitors CH1
+        cp_out_of_band = (ADC_GetITStatus(ADC_IT_WDTH) != RESET) || (ADC_GetITStatus(ADC_IT_WDTL) != RESET);
+        ADC_ClearITPendingBit(ADC_IT_WDTH | ADC_IT_WDTL | ADC_IT_WDTR);
+
+        ADC_GetSqr0Result(&result);
+        cp_slot = ADC_Scan_StoreCp(result);
+        // The low PWM plateau is always outside the state band; only the high plateau counts
+        if (cp_watch_armed && cp_out_of_band && cp_slot == ADC_SCAN_SLOT_CP) {
+            cp_watch_event = true;
+        }
+        ADC_GetSqr1Result(&result);
+        ADC_Scan_Store(ADC_SCAN_SLOT_PP, result);
+        scan_count++;
+        if (cp_slot != ADC_SCAN_SLOT_COUNT) {
+            scan_idle_ticks = 0; // A dropped CP sample leaves the SysTick fallback counting
+        }
+
+        if (scan_running && scan_ref_countdown-- == 0) {
+            // Chain the reference pass directly; the next trigger waits for it
+            scan_ref_countdown = ADC_SCAN_REF_PASS_INTERVAL - 1;
+            scan_busy = true;
+            if (scan_pwm_sync) {
+                ADC_ExtTrigCfg(ADC_TRIG_ATIM, DISABLE); // Keep PWM triggers out of the reference pass
+            }
+            ADC_Scan_ConfigRefPass();
+            scan_phase = ADC_SCAN_PHASE_REF;
+            ADC_SoftwareStartConvCmd(ENABLE);
+            return;
+        }
+    } else {
+        ADC_GetSqr1Result(&result);
+        ADC_Scan_Store(ADC_SCAN_SLOT_TEMP, result);
+        ADC_GetSqr2Result(&result);
+        ADC_Scan_Store(ADC_SCAN_SLOT_VDD, result);
+        ADC_Vdd_Update();
+    }
+
+    if (burst_pending) {
+        ADC_Burst_Launch(); // Queued oversampling job gets the ADC before the next scan
+        return;
+    }
+    ADC_Scan_Resume();
+}
+
+/**
+ * @brief Queues a hardware-accumulated oversampling burst on one channel.
+ *        While the background scan is running the burst is slotted in after the
+ *        current scan sequence; otherwise it starts immediately.
+ * @param channel External ADC channel (e.g., ADC_ExInputCH1), VDD reference.
+ * @param log2_samples Burst length 2^log2_samples (1..ADC_OVERSAMPLE_MAX_LOG2).
+ * @return true if the job was accepted, false if a job is already active or on invalid parameters.
+ */
+bool ADC_Oversample_Start(uint32_t channel, uint8_t log2_samples)
+{
+    bool launch_now;
+
+    if (log2_samples == 0 || log2_samples > ADC_OVERSAMPLE_MAX_LOG2 || channel > ADC_ExInputCH7) {
+        ErrorHandler_Handle(ERROR_INVALID_PARAM, "ADC_Oversample_Start", __LINE__);
+        return false;
+    }
+    if (burst_active) {
+        return false;
+    }
+
+    RCC_APBPeriphClk_Enable2(RCC_APB2_PERIPH_ADC, ENABLE);
+    ADC_Enable();
+    ADC_EnableIrq(ADC_SCAN_IRQ_PRIORITY);
+
+    __disable_irq(); // Enter critical section
+    burst_channel = channel;
+    burst_log2 = log2_samples;
+    burst_done = false;
+    burst_active = true;
+    // ATIM triggered scans do not mark the ADC busy, so in sync mode always let the ISR launch it
+    launch_now = !scan_busy && !(scan_running && scan_pwm_sync);
+    if (launch_now) {
+        ADC_Burst_Launch();
+    } else {
+        burst_pending = true;
+    }
+    __enable_irq();  // Exit critical section
+
+    return true;
+}
+
+/**
+ * @brief Collects the result of the last oversampling burst.
+ * @param result Pointer to store the decimated result (12 + log2_samples/2 bits).
+ * @return true if a result was available, false if the job is still running or none was started.
+ */
+bool ADC_Oversample_GetResult(uint16_t *result)
+{
+    if (result == NULL) {
+        ErrorHandler_Handle(ERROR_INVALID_PARAM, "ADC_Oversample_GetResult", __LINE__);
+        return false;
+    }
+    if (!burst_done) {
+        return false;
+    }
+
+    *result = burst_result;
+    burst_done = false;
+    burst_active = false;
+    return true;
+}
+
+/**
+ * @brief Waits for the accepted burst to complete.
+ * @param log2_samples Burst length, scales the timeout.
+ * @return true if the result is ready, false on timeout (the job is dropped).
+ */
+static bool ADC_Burst_Wait(uint8_t log2_samples)
+{
+    // Room for the burst itself plus one scan sequence (or SysTick fallback) ahead of it
+    volatile uint32_t timeout_counter = ADC_CONVERSION_TIMEOUT * (2UL + (1UL << log2_samples) / 8);
+
+    while (!burst_done) {
+        if (timeout_counter-- == 0) {
+            ErrorHandler_Handle(ERROR_TIMEOUT, "ADC_Burst_Wait", __LINE__);
+            // A burst that never got the ADC is dropped; a converting one is collected by the ISR
+            burst_pending = false;
+            burst_active = false;
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Reads a channel with hardware-accumulated oversampling and waits for the result.
+ *        4^n samples give n extra bits: log2_samples = 2 -> 13-bit, 4 -> 14-bit.
+ * @param channel External ADC channel (e.g., ADC_ExInputCH1).
+ * @param log2_samples Burst length 2^log2_samples (1..ADC_OVERSAMPLE_MAX_LOG2).
+ * @return Decimated result, or 0xFFFF on error / timeout.
+ */
+uint16_t ADC_ReadOversampled(uint32_t channel, uint8_t log2_samples)
+{
+    uint16_t result;
+
+    if (!ADC_Oversample_Start(channel, log2_samples) || !ADC_Burst_Wait(log2_samples)) {
+        return ADC_NO_RESULT;
+    }
+    ADC_Oversample_GetResult(&result);
+    return result;
+}
+
+/**
+ * @brief Reads the mean of a hardware burst on one channel.
+ *        One configuration and one EOA interrupt for the whole block instead of a
+ *        configure/start/poll cycle per sample.
+ * @param channel External ADC channel (e.g., ADC_ExInputCH1), VDD reference.
+ * @param log2_samples Burst length 2^log2_samples (1..ADC_OVERSAMPLE_MAX_LOG2).
+ * @return Rounded 12-bit mean, or 0xFFFF on error / timeout.
+ */
+uint16_t ADC_Read_Channel_Average(uint32_t channel, uint8_t log2_samples)
+{
+    uint32_t sum;
+
+    if (!ADC_Oversample_Start(channel, log2_samples) || !ADC_Burst_Wait(log2_samples)) {
+        return ADC_NO_RESULT;
+    }
+    sum = burst_acc;
+    burst_done = false;
+    burst_active = false;
+    return (uint16_t)((sum + (1UL << (log2_samples - 1))) >> log2_samples);
+}
+
+/**
+ * @brief Gets the supply voltage measured against the 1.5V bandgap by the reference pass.
+ * @return VDD in mV, or ADC_REFERENCE_VOLTAGE_MV until the first plausible measurement.
+ */
+uint16_t ADC_Vdd_Get_mV(void)
+{
+    return vdd_mv;
+}
+
+/**
+ * @brief Gets the VDD correction factor (VDD_actual / VDD_nominal).
+ * @return Factor in Q12 (ADC_VDD_Q12_ONE = 1.0).
+ */
+uint16_t ADC_Vdd_GetCorrectionQ12(void)
+{
+    return vdd_comp_q12;
+}
+
+/**
+ * @brief Converts a raw VDD-referenced result to the value it would have at nominal VDD.
+ *        Use for signals that do not scale with VDD (e.g., the CP divider).
+ * @param raw Raw 12-bit result against VDD.
+ * @return Compensated raw value (may exceed 4095 when VDD is above nominal).
+ */
+uint16_t ADC_Vdd_Compensate(uint16_t raw)
+{
+    return (uint16_t)(((uint32_t)raw * vdd_comp_q12 + ADC_VDD_Q12_ONE / 2) >> ADC_VDD_Q12_SHIFT);
+}
+
+/**
+ * @brief Converts a nominal-VDD raw value (e.g., a threshold) to the raw value the ADC reads now.
+ * @param nominal_raw Raw value at nominal VDD.
+ * @return Raw value at the measured VDD, clamped to 4095.
+ */
+uint16_t ADC_Vdd_Uncompensate(uint16_t nominal_raw)
+{
+    uint32_t raw = ((uint32_t)nominal_raw * vdd_uncomp_q12 + ADC_VDD_Q12_ONE / 2) >> ADC_VDD_Q12_SHIFT;
+
+    return (uint16_t)((raw > 4095) ? 4095 : raw);
+}
+
+/**
+ * @brief Gets the internal temperature from the background scan cache.
+ *        Integer math only; does not touch ADC registers or flash.
+ * @return Temperature in 0.01 deg C, or ADC_TEMPERATURE_INVALID if no result is cached yet.
+ */
+int16_t ADC_Temperature_Get_cC(void)
+{
+    uint16_t raw = ADC_Scan_GetAverage(ADC_SCAN_SLOT_TEMP);
+
+    if (raw == ADC_NO_RESULT) {
+        return ADC_TEMPERATURE_INVALID;
+    }
+    return ADC_Temperature_RawToCentiC(raw);
+}
+
+/**
+ * @brief Arms the ADC analog watchdog on the CP channel with a raw band [low_raw, high_raw].
+ *        A CP sample outside the band (high plateau only in PWM sync mode) latches an event
+ *        that ADC_CpWatch_Triggered() reports. Requires the background scan.
+ * @param low_raw Lowest raw value still inside the band.
+ * @param high_raw Highest raw value still inside the band.
+ */
+void ADC_CpWatch_Arm(uint16_t low_raw, uint16_t high_raw)
+{
+    ADC_WdtTypeDef ADC_WdtStructure;
+
+    if (low_raw > high_raw || high_raw > 0x0FFF) {
+        ErrorHandler_Handle(ERROR_INVALID_PARAM, "ADC_CpWatch_Arm", __LINE__);
+        return;
+    }
+
+    // Compare flags are evaluated at end of sequence, so the window interrupts stay off
+    ADC_WdtInit(&ADC_WdtStructure);
+    ADC_WdtStructure.ADC_WdtCh = ADC_WdtCh1;  // CP (PA01)
+    ADC_WdtStructure.ADC_Vth = high_raw;      // WDTH: result > VTH
+    ADC_WdtStructure.ADC_Vtl = low_raw;       // WDTL: result < VTL
+
+    __disable_irq(); // Enter critical section
+    ADC_WdtConfig(&ADC_WdtStructure);
+    ADC_ClearITPendingBit(ADC_IT_WDTH | ADC_IT_WDTL | ADC_IT_WDTR);
+    cp_watch_event = false;
+    cp_watch_armed = true;
+    __enable_irq();  // Exit critical section
+}
+
+/**
+ * @brief Disarms the CP window watch. ADC_CpWatch_Triggered() returns false afterwards.
+ */
+void ADC_CpWatch_Disarm(void)
+{
+    cp_watch_armed = false;
+    cp_watch_event = false;
+}
+
+/**
+ * @brief Checks whether CP left the armed band since ADC_CpWatch_Arm().
+ *        The event stays latched until the watch is re-armed or disarmed.
+ * @return true if the band was left.
+ */
+bool ADC_CpWatch_Triggered(void)
+{
+    return cp_watch_armed && cp_watch_event;
+}
+
+/**
+ * @brief Checks whether the CP window watch is armed.
+ * @return true if armed.
+ */
+bool ADC_CpWatch_IsArmed(void)
+{
+    return cp_watch_armed;
+}
+
 /**
  * @brief Reads the raw ADC conversion value from the configured channel (PA01).
  * @param None
@@ -73,6 +950,11 @@ bool ADC_Driver_Init(void)
  */
 uint16_t ADC_Read_RawValue(void)
 {
+    // The scan engine owns the ADC while running; serve the cached CP result
+    if (scan_running) {
+        return ADC_Scan_GetRaw(ADC_SCAN_SLOT_CP);
+    }
+
     /* Start software conversion */
     ADC_SoftwareStartConvCmd(ENABLE);
 
@@ -94,45 +976,29 @@ uint16_t ADC_Read_RawValue(void)
  */
 uint16_t ADC_Read_Voltage_mV(void)
 {
-    ADC_SingleChTypeDef ADC_SingleChStructure_Volt; // Structure for voltage config
-
-    // --- Re-configure ADC for Voltage Sensing (PA01, VDD ref) ---
-    RCC_APBPeriphClk_Enable2(RCC_APB2_PERIPH_ADC, ENABLE);
-    ADC_Enable(); // Ensure ADC is enabled
-
-    // Configure structure for voltage reading (similar to ADC_Driver_Init)
-    ADC_SingleChStructure_Volt.ADC_InitStruct.ADC_OpMode = ADC_SingleChOneMode;
-    ADC_SingleChStructure_Volt.ADC_InitStruct.ADC_ClkDiv = ADC_Clk_Div32;      // Adjusted for 48MHz HCLK
-    ADC_SingleChStructure_Volt.ADC_InitStruct.ADC_SampleTime = ADC_SampTime5Clk; // Use sample time from Init
-    ADC_SingleChStructure_Volt.ADC_InitStruct.ADC_VrefSel = ADC_Vref_VDD;      // Use VDD reference
-    ADC_SingleChStructure_Volt.ADC_InitStruct.ADC_InBufEn = ADC_BufDisable;    // Use buffer setting from Init
-    ADC_SingleChStructure_Volt.ADC_InitStruct.ADC_TsEn = ADC_TsDisable;       // Disable Temperature Sensor
-    ADC_SingleChStructure_Volt.ADC_InitStruct.ADC_Align = ADC_AlignRight;
-    ADC_SingleChStructure_Volt.ADC_InitStruct.ADC_AccEn = ADC_AccDisable;
-
-    ADC_SingleChStructure_Volt.ADC_Chmux = ADC_ExInputCH1; // Select Channel 1 (PA01)
-    ADC_SingleChStructure_Volt.ADC_DiscardEn = ADC_DiscardNull;
-
-    // Initialize watchdog structure to defaults (disabled)
-    ADC_WdtInit(&ADC_SingleChStructure_Volt.ADC_WdtStruct);
-
-    // Apply the configuration
-    ADC_SingleChOneModeCfg(&ADC_SingleChStructure_Volt);
+    // Use the scan cache (same 8-sample mean) when the background scan is running
+    if (scan_running) {
+        uint16_t cachedRawValue = ADC_Scan_GetAverage(ADC_SCAN_SLOT_CP);
+        if (cachedRawValue == ADC_NO_RESULT) {
+            return 0;
+        }
+        return (uint16_t)(((uint32_t)cachedRawValue * vdd_mv) / 4095);
+    }
 
-    // --- Perform Averaged Conversion and Read ---
-    uint32_t totalRawValue = 0;
-    for (int i = 0; i < VOLTAGE_AVG_SAMPLES; i++) {
-        // ADC_Read_RawValue handles start, wait, clear, read for each sample
-        totalRawValue += ADC_Read_RawValue();
+    // --- Perform Averaged Conversion and Read (PA01, VDD ref) ---
+    // One hardware burst: configured once, accumulated in RESULTACC, single EOA interrupt
+    uint16_t averageRawValue = ADC_Read_Channel_Average(ADC_ExInputCH1, VOLTAGE_AVG_LOG2);
+    if (averageRawValue == ADC_NO_RESULT) {
+        return 0; // Error already reported by ADC_Burst_Wait
     }
-    uint16_t averageRawValue = (uint16_t)(totalRawValue / VOLTAGE_AVG_SAMPLES);
 
 
     // --- Calculate Voltage ---
     // Calculate voltage: (AverageRawValue / MaxRawValue) * ReferenceVoltage
     // MaxRawValue for 12-bit ADC is 4095 (2^12 - 1)
     // Use integer arithmetic to avoid floating point: (AverageRawValue * RefVoltage_mV) / 4095
-    uint32_t voltage = ((uint32_t)averageRawValue * ADC_REFERENCE_VOLTAGE_MV) / 4095;
+    // The reference is the measured VDD (nominal until the first reference pass)
+    uint32_t voltage = ((uint32_t)averageRawValue * vdd_mv) / 4095;
     return (uint16_t)voltage;
 }
 
@@ -145,6 +1011,18 @@ uint16_t ADC_Read_Channel_Raw(uint32_t channel) // Use uint32_t for channel
 {
     ADC_SingleChTypeDef ADC_SingleChStructure;
     volatile uint32_t timeout_counter = ADC_CONVERSION_TIMEOUT; // Timeout counter
+    ADC_ScanSlot_t slot;
+    bool resume_scan = scan_running;
+    uint16_t result;
+
+    // Channels covered by the background scan are served from the cache in O(1)
+    if (resume_scan && ADC_Scan_ChannelToSlot(channel, &slot)) {
+        return ADC_Scan_GetRaw(slot);
+    }
+    // Any other channel needs the ADC to itself for one blocking conversion
+    if (resume_scan) {
+        ADC_Scan_Stop();
+    }
 
     // Basic check for valid external channel range if needed, though type system helps
     // if (channel > ADC_ExInputCH7) return 0xFFFF; // Example check
@@ -183,6 +1061,9 @@ uint16_t ADC_Read_Channel_Raw(uint32_t channel) // Use uint32_t for channel
             // Timeout occurred
             ErrorHandler_Handle(ERROR_TIMEOUT, "ADC_Read_Raw", __LINE__);
             ADC_SoftwareStartConvCmd(DISABLE); // Stop potentially stuck conversion
+            if (resume_scan) {
+                ADC_Scan_Start();
+            }
             return 0xFFFF; // Return error code
         }
     }
@@ -190,8 +1071,13 @@ uint16_t ADC_Read_Channel_Raw(uint32_t channel) // Use uint32_t for channel
     // Clear the End Of Conversion flag
     ADC_ClearITPendingBit(ADC_IT_EOC); // Clear flag *after* checking it
 
-    // Return the conversion result
-    return ADC_GetConversionValue();
+    // Read the conversion result
+    result = ADC_GetConversionValue();
+
+    if (resume_scan) {
+        ADC_Scan_Start();
+    }
+    return result;
 }
 
 
@@ -204,13 +1090,16 @@ float ADC_Read_Internal_Temperature(void)
 {
     ADC_SingleChTypeDef ADC_SingleChStructure_Temp;
     uint16_t adc_raw_result;
-    float temperature;
-    volatile uint8_t T0_cal;
-    volatile uint16_t Trim_cal;
+    int16_t temperature_cc;
 
-    // --- Read Calibration Values ---
-    T0_cal = *(volatile uint8_t*)CAL_T0_ADDRESS;
-    Trim_cal = *(volatile uint16_t*)CAL_TRIM1V5_ADDRESS;
+    // The background scan converts the sensor against the same 1.5V reference
+    if (scan_running) {
+        temperature_cc = ADC_Temperature_Get_cC();
+        if (temperature_cc != ADC_TEMPERATURE_INVALID) {
+            return (float)temperature_cc / 100.0f;
+        }
+        return 0.0f;
+    }
 
     // --- Configure ADC for Temperature Sensing (following steps from image) ---
 
@@ -264,8 +1153,8 @@ float ADC_Read_Internal_Temperature(void)
 
     // --- Calculate Temperature (Step 14) ---
     // Formula: Temp = T0 * 0.5 + 0.0924 * Vref * (AdcValue - Trim)
-    // Vref = 1.5V
-    temperature = (float)T0_cal * 0.5f + 0.0924f * 1.5f * ((float)adc_raw_result - (float)Trim_cal);
+    // Vref = 1.5V, evaluated in fixed point with the cached calibration
+    temperature_cc = ADC_Temperature_RawToCentiC(adc_raw_result);
 
-    return temperature;
+    return (float)temperature_cc / 100.0f;
 }
@@ -0,0 +1,167 @@
+#include "adc_filter.h"
+#include "error_handler.h" // Include the error handler
+#include <stddef.h>        // For NULL
+
+/**
+ * @brief Configures a filter pipeline and clears its history.
+ * @param filter Filter instance (owned by the caller, usually static).
+ * @param median_len Median window, odd, 1..ADC_FILTER_MEDIAN_MAX (1 disables the stage).
+ * @param iir_shift IIR coefficient 1/2^iir_shift, 0..ADC_FILTER_IIR_MAX (0 disables the stage).
+ * @param thresholds Ascending level boundaries, or NULL for no level output.
+ * @param threshold_count Number of boundaries.
+ * @param hysteresis Distance past a boundary needed to move to the neighbouring level.
+ * @return true if successful, false on invalid parameters.
+ */
+bool ADC_Filter_Init(ADC_Filter_t *filter, uint8_t median_len, uint8_t iir_shift,
+                     const uint16_t *thresholds, uint8_t threshold_count, uint16_t hysteresis)
+{
+    if (filter == NULL || median_len == 0 || median_len > ADC_FILTER_MEDIAN_MAX ||
+        (median_len & 1U) == 0 || iir_shift > ADC_FILTER_IIR_MAX ||
+        (thresholds == NULL && threshold_count != 0)) {
+        ErrorHandler_Handle(ERROR_INVALID_PARAM, "ADC_Filter_Init", __LINE__);
+        return false;
+    }
+
+    filter->median_len = median_len;
+    filter->iir_shift = iir_shift;
+    filter->thresholds = thresholds;
+    filter->threshold_count = threshold_count;
+    filter->hysteresis = hysteresis;
+    ADC_Filter_Reset(filter);
+    return true;
+}
+
+/**
+ * @brief Forgets the filter history; the next sample primes all stages.
+ * @param filter Filter instance.
+ */
+void ADC_Filter_Reset(ADC_Filter_t *filter)
+{
+    filter->primed = false;
+    filter->median_index = 0;
+    filter->iir_acc = 0;
+    filter->output = 0;
+    filter->level = 0;
+}
+
+/**
+ * @brief Median of the current window (insertion sort on a copy, at most 10 compares).
+ * @param filter Filter instance.
+ * @return Median value.
+ */
+static uint16_t ADC_Filter_Median(const ADC_Filter_t *filter)
+{
+    uint16_t sorted[ADC_FILTER_MEDIAN_MAX];
+    uint16_t value;
+    uint8_t i, j;
+
+    for (i = 0; i < filter->median_len; i++) {
+        value = filter->median_buf[i];
+        for (j = i; j > 0 && sorted[j - 1] > value; j--) {
+            sorted[j] = sorted[j - 1];
+        }
+        sorted[j] = value;
+    }
+    return sorted[filter->median_len / 2];
+}
+
+/**
+ * @brief Feeds one sample through median, IIR and level stages.
+ *        Intended for interrupt context; a sample costs a handful of compares and one shift.
+ * @param filter Filter instance.
+ * @param sample New raw sample.
+ * @return Filtered output.
+ */
+uint16_t ADC_Filter_Update(ADC_Filter_t *filter, uint16_t sample)
+{
+    uint16_t value;
+    uint8_t i;
+    uint8_t level;
+
+    // --- Median ---
+    if (!filter->primed) {
+        // Seed the window and the IIR so the first output equals the first sample
+        for (i = 0; i < filter->median_len; i++) {
+            filter->median_buf[i] = sample;
+        }
+        filter->iir_acc = (uint32_t)sample << filter->iir_shift;
+    }
+    filter->median_buf[filter->median_index] = sample;
+    if (++filter->median_index >= filter->median_len) {
+        filter->median_index = 0;
+    }
+    value = (filter->median_len > 1) ? ADC_Filter_Median(filter) : sample;
+
+    // --- IIR: y += (x - y) / 2^k, kept as y * 2^k ---
+    if (filter->iir_shift > 0) {
+        filter->iir_acc = filter->iir_acc - (filter->iir_acc >> filter->iir_shift) + value;
+        value = (uint16_t)((filter->iir_acc + (1UL << (filter->iir_shift - 1))) >> filter->iir_shift);
+    }
+
+    // --- Level with hysteresis ---
+    if (!filter->primed) {
+        level = ADC_Filter_LevelOf(filter->thresholds, filter->threshold_count, value);
+    } else {
+        level = filter->level;
+        while (level < filter->threshold_count &&
+               (uint32_t)value >= (uint32_t)filter->thresholds[level] + filter->hysteresis) {
+            level++;
+        }
+        while (level > 0 &&
+               (uint32_t)value + filter->hysteresis < filter->thresholds[level - 1]) {
+            level--;
+        }
+    }
+
+    filter->output = value;
+    filter->level = level;
+    filter->primed = true;
+    return value;
+}
+
+/**
+ * @brief Gets the last filtered output.
+ * @param filter Filter instance.
+ * @return Filtered value (0 before the first sample).
+ */
+uint16_t ADC_Filter_GetOutput(const ADC_Filter_t *filter)
+{
+    return filter->output;
+}
+
+/**
+ * @brief Gets the classified level of the filtered output.
+ * @param filter Filter instance.
+ * @return Number of boundaries below the output, 0..threshold_count.
+ */
+uint8_t ADC_Filter_GetLevel(const ADC_Filter_t *filter)
+{
+    return filter->level;
+}
+
+/**
+ * @brief Checks whether the filter has processed at least one sample.
+ * @param filter Filter instance.
+ * @return true if primed.
+ */
+bool ADC_Filter_IsPrimed(const ADC_Filter_t *filter)
+{
+    return filter->primed;
+}
+
+/**
+ * @brief Classifies a value against ascending boundaries without hysteresis.
+ * @param thresholds Ascending level boundaries.
+ * @param threshold_count Number of boundaries.
+ * @param value Value to classify.
+ * @return Number of boundaries <= value.
+ */
+uint8_t ADC_Filter_LevelOf(const uint16_t *thresholds, uint8_t threshold_count, uint16_t value)
+{
+    uint8_t level = 0;
+
+    while (level < threshold_count && value >= thresholds[level]) {
+        level++;
+    }
+    return level;
+}
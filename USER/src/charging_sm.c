@@ -2,25 +2,72 @@
 #include "cp_signal.h"
 #include "pp_signal.h"
 #include "contactor_control.h"
-#include "ac_measurement.h" // Included for potential future use in states
+#include "ac_measurement.h" // Session energy metering
+#include "energy_journal.h" // Persistent energy counters
+#include "overcurrent.h"    // Overcurrent protection while charging
+#include "fast_trip.h"      // Comparator fast-trip events
 #include "ui_display.h"     // To update UI based on state changes
 #include "config.h"         // May contain timing definitions etc.
 #include "error_handler.h"  // Include the error handler
-#include "system_cw32f003.h" // For FirmwareDelay
-#include <stdio.h>          // Keep for printf
+#include "cw32f003_systick.h" // For GetTick()
+#include "log.h"            // Tokenized logging
 
-// Delay in approximate milliseconds to wait for contactor to physically switch
+// Time in milliseconds for the contactor to physically switch before its feedback is checked
 // Adjust based on relay specification and testing
 #define CONTACTOR_SWITCH_DELAY_MS 100
-// Calculate delay count based on SystemCoreClock (assuming FirmwareDelay uses simple loop)
-// This is approximate! A SysTick-based delay would be more accurate.
-// Assuming 48MHz clock, need rough estimate. Let's use the value from OLED init for ~1ms.
-#define CONTACTOR_DELAY_COUNT (4800 * CONTACTOR_SWITCH_DELAY_MS / 1) // Approx count for delay
+
+/**
+ * @brief Contactor switching sub-state, kept across state machine ticks while the relay settles.
+ */
+typedef enum {
+    CONTACTOR_SEQ_NONE,     // No switching in progress
+    CONTACTOR_SEQ_CLOSING,  // Close commanded, feedback checked at the deadline
+    CONTACTOR_SEQ_OPENING   // Open commanded, feedback checked at the deadline
+} ContactorSeq_t;
 
 // --- State Machine Variables ---
 static SM_State_t current_state = SM_STATE_INIT;
 static uint16_t cable_capacity_amps = 0;
 static uint8_t max_charging_current_amps = 0;
+static uint32_t journal_saved_wh = 0; // Lifetime total at the last journal record
+static ContactorSeq_t contactor_seq = CONTACTOR_SEQ_NONE;
+static uint32_t contactor_deadline_ms = 0;      // GetTick() time at which the feedback is checked
+static SM_State_t contactor_stop_state = SM_STATE_CONNECTED; // Where to go once opened
+
+// --- Private Helpers ---
+
+/**
+ * @brief Starts a timed contactor switching sub-state. The command itself is issued by the caller.
+ * @param seq CONTACTOR_SEQ_CLOSING or CONTACTOR_SEQ_OPENING.
+ */
+static void SM_ContactorStart(ContactorSeq_t seq)
+{
+    contactor_seq = seq;
+    contactor_deadline_ms = GetTick() + CONTACTOR_SWITCH_DELAY_MS;
+}
+
+/**
+ * @brief Checks whether the contactor has had CONTACTOR_SWITCH_DELAY_MS to switch.
+ * @return true once the deadline has passed (the feedback can be verified).
+ */
+static bool SM_ContactorSettled(void)
+{
+    return (int32_t)(GetTick() - contactor_deadline_ms) >= 0;
+}
+
+/**
+ * @brief Queues the energy counters for the flash journal (written by Journal_Poll()).
+ */
+static void SM_JournalEnergy(void)
+{
+    Journal_Record_t record;
+
+    record.lifetime_wh = AC_Energy_GetLifetime_Wh();
+    record.session_mwh = AC_Energy_GetSession_mWh();
+    record.session_count = AC_Energy_GetSessionCount();
+    Journal_Append(&record);
+    journal_saved_wh = record.lifetime_wh;
+}
 
 // --- Initialization ---
 
@@ -33,8 +80,16 @@ void SM_Init(void)
     CP_Signal_Init();
     PP_Signal_Init();
     Contactor_Init();
+    FastTrip_Init();        // After the contactor and CP PWM it acts on
     AC_Measurement_Init();
 
+    // Restore the energy counters from the newest journal record
+    Journal_Record_t record;
+    if (Journal_Init(&record)) {
+        AC_Energy_Restore(record.lifetime_wh, record.session_count);
+        journal_saved_wh = record.lifetime_wh;
+        LOG2(SM_JOURNAL_RESTORED, record.lifetime_wh, record.session_count);
+    }
 
     // Set initial state
     current_state = SM_STATE_IDLE; // Start in Idle (State A) after init
@@ -46,7 +101,7 @@ void SM_Init(void)
     // Ensure contactor is open
     Contactor_Open();
 
-    printf("Charging State Machine Initialized. State: IDLE\n");
+    LOG0(SM_INIT);
 }
 
 // --- State Machine Execution ---
@@ -61,10 +116,17 @@ void SM_RunStateMachine(void)
     SM_State_t next_state = current_state; // Assume no change unless transition occurs
     ErrorCode_t last_error = ErrorHandler_GetLast(); // Check for persistent errors
 
+    // --- Fast-Trip Event ---
+    // The VC1 ISR has already opened the contactor and driven CP low; report it here, in main context
+    if (FastTrip_IsTripped() && current_state != SM_STATE_FAULT) {
+        ErrorHandler_Handle(ERROR_OVERCURRENT, "SM_FastTrip", __LINE__);
+        last_error = ERROR_OVERCURRENT;
+    }
+
     // --- Pre-State Machine Error Check ---
     // If a persistent error exists and we are not already handling it in the fault state, force transition to fault.
     if (last_error != ERROR_NONE && current_state != SM_STATE_FAULT) {
-        printf("SM: Persistent Error Detected (%d). Forcing FAULT state.\n", last_error);
+        LOG1(SM_PERSISTENT_ERROR, last_error);
         next_state = SM_STATE_FAULT;
         // Note: The specific error was already logged by the module that detected it.
     } else {
@@ -73,7 +135,7 @@ void SM_RunStateMachine(void)
 
         // Handle CP Read Fault immediately
         if (cp_state == CP_STATE_FAULT && current_state != SM_STATE_FAULT) {
-             printf("SM: CP Fault Detected. Forcing FAULT state.\n");
+             LOG0(SM_CP_FAULT);
              next_state = SM_STATE_FAULT;
              // Error already reported by CP_ReadState or ADC_Read_Channel_Raw
         }
@@ -90,15 +152,19 @@ void SM_RunStateMachine(void)
                 cable_capacity_amps = PP_GetCableCapacity();
                 if (cable_capacity_amps == PP_CAPACITY_UNKNOWN) {
                     next_state = SM_STATE_FAULT; // PP Error
-                    printf("SM: PP Fault Detected!\n");
+                    LOG0(SM_PP_FAULT);
                 } else {
                     // Determine max current based on cable and EVSE limits (e.g., EVSE limit is 32A)
                     uint8_t evse_limit = 32; // Example EVSE limit
                     max_charging_current_amps = (cable_capacity_amps < evse_limit) ? cable_capacity_amps : evse_limit;
 
+                    // A session runs from plug-in until the next plug-in
+                    AC_Energy_StartSession();
+                    SM_JournalEnergy();
+
                     // Set PWM according to max allowed current
                     CP_SetMaxCurrentPWM(max_charging_current_amps);
-                    printf("SM: Vehicle Connected. Cable: %uA, Max Charge: %uA\n", cable_capacity_amps, max_charging_current_amps);
+                    LOG2(SM_CONNECTED, cable_capacity_amps, max_charging_current_amps);
 
                     if (cp_state == CP_STATE_B_9V) {
                         next_state = SM_STATE_CONNECTED; // Transition to State B
@@ -110,7 +176,7 @@ void SM_RunStateMachine(void)
                         // State D handling might need refinement based on requirements
                         ErrorHandler_Handle(ERROR_STATE_INVALID, "SM_Idle", __LINE__); // Report unexpected state D
                         next_state = SM_STATE_FAULT;
-                        printf("SM: State D detected - treating as Fault.\n");
+                        LOG0(SM_STATE_D_FAULT);
                     }
                 }
             }
@@ -122,11 +188,11 @@ void SM_RunStateMachine(void)
         case SM_STATE_CONNECTED: // State B: Vehicle connected, waiting for charging request
             if (cp_state == CP_STATE_C_6V) {
                 next_state = SM_STATE_CHARGING_REQ; // EV requests charging
-                printf("SM: Charging Requested (State C).\n");
+                LOG0(SM_CHARGE_REQUESTED);
             } else if (cp_state == CP_STATE_A_12V) {
                 next_state = SM_STATE_IDLE; // Vehicle disconnected
                 CP_SetMaxCurrentPWM(0); // Reset PWM (State A)
-                printf("SM: Vehicle Disconnected.\n");
+                LOG0(SM_DISCONNECTED);
             }
             // CP Fault check moved above the switch statement
             // Ensure contactor remains open
@@ -134,61 +200,80 @@ void SM_RunStateMachine(void)
             break;
 
         case SM_STATE_CHARGING_REQ: // State C: EV requests charging, prepare to close contactor
-            // Add any pre-charge checks if necessary
-            Contactor_Close(); // Command contactor closed
-            FirmwareDelay(CONTACTOR_DELAY_COUNT); // Wait for relay to switch
+            if (contactor_seq != CONTACTOR_SEQ_CLOSING) {
+                // Add any pre-charge checks if necessary
+                Contactor_Close(); // Command contactor closed
+                SM_ContactorStart(CONTACTOR_SEQ_CLOSING); // Check the feedback once the relay has switched
+                break;
+            }
+            if (!SM_ContactorSettled()) {
+                break; // Relay still switching; CP and metering keep running meanwhile
+            }
 
             // Verify contactor closed
             if (Contactor_ReadFeedbackState() == CONTACTOR_PHYS_CLOSED) {
                 next_state = SM_STATE_CHARGING;
-                printf("SM: Contactor Closed Confirmed. Charging Active.\n");
+                OCP_Arm(max_charging_current_amps); // Protect against the advertised limit
+                LOG0(SM_CONTACTOR_CLOSED);
             } else {
                 // Contactor failed to close!
                 ErrorHandler_Handle(ERROR_CONTACTOR_FAULT, "SM_ChargingReq", __LINE__);
                 Contactor_Open(); // Attempt to ensure it's open
                 next_state = SM_STATE_FAULT;
-                printf("SM: Contactor Close FAILED! Entering Fault.\n");
+                LOG0(SM_CONTACTOR_CLOSE_FAIL);
             }
             break;
 
         case SM_STATE_CHARGING: // State C Active: Power flowing
-            if (cp_state == CP_STATE_B_9V) {
+            if (contactor_seq == CONTACTOR_SEQ_OPENING) {
+                // Stop in progress: verify the contactor opened once the relay has had time to switch
+                if (SM_ContactorSettled()) {
+                    if (Contactor_ReadFeedbackState() == CONTACTOR_PHYS_OPEN) {
+                        next_state = contactor_stop_state;
+                        if (next_state == SM_STATE_IDLE) {
+                            CP_SetMaxCurrentPWM(0); // Reset PWM (State A)
+                        }
+                        LOG0(SM_CONTACTOR_OPENED);
+                    } else {
+                        // Contactor failed to open (Welded?)!
+                        ErrorHandler_Handle(ERROR_CONTACTOR_FAULT, "SM_Charging_Stop", __LINE__);
+                        next_state = SM_STATE_FAULT;
+                        LOG0(SM_CONTACTOR_OPEN_FAIL);
+                    }
+                }
+            } else if (cp_state == CP_STATE_B_9V) {
                 // EV stopped charging request (but still connected)
                 Contactor_Open(); // Command contactor open
-                FirmwareDelay(CONTACTOR_DELAY_COUNT); // Wait for relay to switch
-
-                // Verify contactor opened
-                if (Contactor_ReadFeedbackState() == CONTACTOR_PHYS_OPEN) {
-                    next_state = SM_STATE_CONNECTED;
-                    printf("SM: Charging Stopped by EV (State B). Contactor Opened Confirmed.\n");
-                } else {
-                    // Contactor failed to open (Welded?)!
-                    ErrorHandler_Handle(ERROR_CONTACTOR_FAULT, "SM_Charging_Stop", __LINE__);
-                    next_state = SM_STATE_FAULT;
-                    printf("SM: Contactor Open FAILED! Entering Fault.\n");
-                }
+                SM_ContactorStart(CONTACTOR_SEQ_OPENING);
+                contactor_stop_state = SM_STATE_CONNECTED;
+                LOG0(SM_EV_STOPPED);
             } else if (cp_state == CP_STATE_A_12V) {
                 // Vehicle disconnected during charging (should not happen ideally)
                 Contactor_Open(); // Command contactor open
-                FirmwareDelay(CONTACTOR_DELAY_COUNT); // Wait for relay to switch
-
-                // Verify contactor opened
-                if (Contactor_ReadFeedbackState() == CONTACTOR_PHYS_OPEN) {
-                    next_state = SM_STATE_IDLE;
-                    CP_SetMaxCurrentPWM(0); // Reset PWM (State A)
-                    printf("SM: Vehicle Disconnected during Charging. Contactor Opened Confirmed.\n");
-                } else {
-                    // Contactor failed to open (Welded?)!
-                    ErrorHandler_Handle(ERROR_CONTACTOR_FAULT, "SM_Charging_Disconnect", __LINE__);
-                    next_state = SM_STATE_FAULT;
-                    printf("SM: Contactor Open FAILED after disconnect! Entering Fault.\n");
-                }
+                SM_ContactorStart(CONTACTOR_SEQ_OPENING);
+                contactor_stop_state = SM_STATE_IDLE;
+                LOG0(SM_EV_UNPLUGGED);
             }
             // CP Fault check moved above the switch statement
 
-            // Add checks for overcurrent, etc. using AC_GetCurrent() here if needed
-            // float current = AC_GetCurrent();
-            // if (current > (max_charging_current_amps * 1.1)) { /* Handle overcurrent */ }
+            // Stale metering must not keep the contactor closed: fault within HLW_LINK_TIMEOUT_MS
+            // (5 frame periods) plus one state machine tick
+            if (!AC_Measurement_CheckLink()) {
+                Contactor_Open();
+                next_state = SM_STATE_FAULT;
+                LOG0(SM_HLW_LINK_LOST);
+            }
+
+            // Bound the energy lost to a reset while charging
+            if (AC_Energy_GetLifetime_Wh() - journal_saved_wh >= JOURNAL_SAVE_INTERVAL_WH) {
+                SM_JournalEnergy();
+            }
+
+            // Overcurrent: OCP_Update() (main loop, per HLW8032 frame) has already opened the contactor
+            if (OCP_GetTrip() != OCP_TRIP_NONE) {
+                next_state = SM_STATE_FAULT;
+                LOG1(SM_OVERCURRENT, OCP_GetTrip());
+            }
             break;
 
         case SM_STATE_VENTILATION: // State D: Optional state
@@ -196,12 +281,25 @@ void SM_RunStateMachine(void)
             // If not supported, transition to FAULT or back to B/C?
              Contactor_Open(); // Example: Open contactor if ventilation not supported
              next_state = SM_STATE_FAULT;
-             printf("SM: State D (Ventilation) not supported. Entering Fault.\n");
+             LOG0(SM_VENTILATION);
             break;
 
         case SM_STATE_FAULT:
             // Ensure contactor is open
             Contactor_Open();
+
+            // After a fast trip CP is held at State F by the trip; it reads as a fault until
+            // the comparator re-arms, which also releases CP. Recovery then continues below.
+            // The forced level also leaves the watched CP band: stop the watch so its latched
+            // event does not run this task back to back for the whole hold time.
+            if (FastTrip_IsTripped()) {
+                CP_StopWatch();
+                if (Contactor_ReadFeedbackState() == CONTACTOR_PHYS_OPEN) {
+                    (void)FastTrip_Rearm();
+                }
+                break;
+            }
+
             // Stop PWM or set to specific error state?
             CP_SetMaxCurrentPWM(0); // Example: Set PWM to State A equivalent
 
@@ -213,7 +311,7 @@ void SM_RunStateMachine(void)
 
             // Check for recovery condition: CP is State A AND Contactor is confirmed Open
             if (cp_state == CP_STATE_A_12V && Contactor_ReadFeedbackState() == CONTACTOR_PHYS_OPEN) {
-                 printf("SM: Fault condition cleared (CP State A & Contactor Open). Returning to IDLE.\n");
+                 LOG0(SM_FAULT_CLEARED);
                  ErrorHandler_ClearLast(); // Clear the stored error code
                  next_state = SM_STATE_IDLE;
             } else if (cp_state == CP_STATE_FAULT) {
@@ -227,7 +325,7 @@ void SM_RunStateMachine(void)
         default:
             // Should not happen, report error and force back to IDLE or FAULT
             ErrorHandler_Handle(ERROR_STATE_INVALID, "SM_Run", __LINE__);
-            printf("SM: Invalid State (%d)! Forcing to IDLE.\n", current_state);
+            LOG1(SM_INVALID_STATE, current_state);
             Contactor_Open();
             CP_SetMaxCurrentPWM(0);
             next_state = SM_STATE_IDLE; // Or SM_STATE_FAULT? IDLE might be safer.
@@ -237,10 +335,15 @@ void SM_RunStateMachine(void)
 
     // --- Update State ---
     if (next_state != current_state) {
-        printf("SM: State Change %d -> %d\n", current_state, next_state);
+        LOG2(SM_STATE_CHANGE, current_state, next_state);
+        if (current_state == SM_STATE_CHARGING) {
+            OCP_Disarm();
+            SM_JournalEnergy(); // Charging stopped: persist the session
+        }
         current_state = next_state;
-        // Update UI display based on the new state
-        UI_UpdateDisplay(); // Call the UI update function
+        contactor_seq = CONTACTOR_SEQ_NONE; // Each state starts its own switching sequence
+        // Update UI display based on the new state (drawn later by the display task)
+        UI_RequestUpdate();
     }
 }
 
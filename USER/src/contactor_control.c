@@ -44,13 +44,9 @@ void Contactor_Init(void)
  */
 void Contactor_Open(void)
 {
-    // Set GPIO pin to the state that opens the contactor
-    // #define CONTACTOR_OPEN_STATE 0 (Assuming LOW means 0)
-    if (CONTACTOR_OPEN_STATE == 0) {
-        GPIO_WritePin(CONTACTOR_CTRL_GPIO_PORT, CONTACTOR_CTRL_GPIO_PIN, GPIO_Pin_RESET);
-    } else { // Assuming HIGH means 1
-        GPIO_WritePin(CONTACTOR_CTRL_GPIO_PORT, CONTACTOR_CTRL_GPIO_PIN, GPIO_Pin_SET);
-    }
+    // Set GPIO pin to the state that opens the contactor (CONTACTOR_OPEN_STATE, constant: one store)
+    GPIO_FastWrite(CONTACTOR_CTRL_GPIO_PORT, CONTACTOR_CTRL_GPIO_PIN,
+                   (CONTACTOR_OPEN_STATE == 0) ? GPIO_Pin_RESET : GPIO_Pin_SET);
     contactor_is_commanded_closed = false;
     // Add delay if necessary for relay switching time?
 }
@@ -60,13 +56,9 @@ void Contactor_Open(void)
  */
 void Contactor_Close(void)
 {
-    // Set GPIO pin to the state that closes the contactor
-    // #define CONTACTOR_CLOSED_STATE 1 (Assuming HIGH means 1)
-    if (CONTACTOR_CLOSED_STATE == 0) { // Assuming LOW means 0
-        GPIO_WritePin(CONTACTOR_CTRL_GPIO_PORT, CONTACTOR_CTRL_GPIO_PIN, GPIO_Pin_RESET);
-    } else { // Assuming HIGH means 1
-        GPIO_WritePin(CONTACTOR_CTRL_GPIO_PORT, CONTACTOR_CTRL_GPIO_PIN, GPIO_Pin_SET);
-    }
+    // Set GPIO pin to the state that closes the contactor (CONTACTOR_CLOSED_STATE, constant: one store)
+    GPIO_FastWrite(CONTACTOR_CTRL_GPIO_PORT, CONTACTOR_CTRL_GPIO_PIN,
+                   (CONTACTOR_CLOSED_STATE == 0) ? GPIO_Pin_RESET : GPIO_Pin_SET);
     contactor_is_commanded_closed = true;
     // Add delay if necessary for relay switching time?
 }
@@ -91,7 +83,7 @@ ContactorPhysicalState_t Contactor_ReadFeedbackState(void)
     GPIO_PinState feedback_level;
 
     // Read the feedback pin state
-    feedback_level = GPIO_ReadPin(CONTACTOR_FB_GPIO_PORT, CONTACTOR_FB_GPIO_PIN);
+    feedback_level = GPIO_FastRead(CONTACTOR_FB_GPIO_PORT, CONTACTOR_FB_GPIO_PIN);
 
     // Determine state based on defined logic level
     // CONTACTOR_FEEDBACK_IS_CLOSED_STATE is 1 (HIGH means closed)
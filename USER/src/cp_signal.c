@@ -9,8 +9,69 @@
 #include "error_handler.h" // Include the error handler
 #include <stdio.h>         // Keep for now, maybe remove later
 
-// Number of ADC samples to average for CP state reading
-#define CP_ADC_AVG_SAMPLES 8
+// Samples (2^N) averaged by one hardware burst for CP state reading (blocking fallback only)
+#define CP_ADC_AVG_LOG2 3
+
+// CP_Voltage_mV = RawValue * 3300 / 4095 * 3.7 (see CP_ReadState), raw compensated to 3300mV VDD
+#define CP_RAW_TO_MV(raw)       ((uint16_t)(((uint32_t)(raw) * 12210UL) / 4095UL))
+
+// Low plateau must sit at the clamped -12V level (~0V at the ADC); anything above
+// means the PWM is not swinging negative (missing diode / short to a positive level)
+#define CP_LOW_PLATEAU_MAX_RAW  600
+
+// State thresholds in RAW ADC values (approximate, needs calibration; see CP_ReadState)
+#define CP_THRESHOLD_A_MIN      3600 // Min raw value for State A
+#define CP_THRESHOLD_B_MIN      2600 // Min raw value for State B
+#define CP_THRESHOLD_C_MIN      1600 // Min raw value for State C
+#define CP_THRESHOLD_D_MIN      600  // Min raw value for State D
+#define CP_RAW_MAX              4095
+
+// CP filter pipeline (fed from the ADC interrupt with VDD compensated high plateau samples)
+#define CP_FILTER_MEDIAN_LEN    3    // Rejects single spikes / relay transients
+#define CP_FILTER_IIR_SHIFT     2    // y += (x - y) / 4, ~4 samples time constant
+#define CP_FILTER_HYSTERESIS    50   // ~150mV at CP, needed past a boundary to change state
+
+// Ascending level boundaries; filter level N maps to cp_level_state[N]
+static const uint16_t cp_level_thresholds[] = {
+    CP_THRESHOLD_D_MIN, CP_THRESHOLD_C_MIN, CP_THRESHOLD_B_MIN, CP_THRESHOLD_A_MIN
+};
+static const CP_State_t cp_level_state[] = {
+    CP_STATE_FAULT, CP_STATE_D_3V, CP_STATE_C_6V, CP_STATE_B_9V, CP_STATE_A_12V
+};
+#define CP_LEVEL_COUNT (sizeof(cp_level_thresholds) / sizeof(cp_level_thresholds[0]))
+
+static ADC_Filter_t cp_filter;
+static uint32_t cp_low_checked_count = 0; // CP_LOW sample count seen by the last diode check
+static CP_State_t cp_watched_state = CP_STATE_UNKNOWN; // State whose band the ADC watchdog guards
+
+/**
+ * @brief Programs the ADC window watchdog with the raw band of a CP filter level.
+ *        The band is widened by the filter hysteresis so a reading parked inside the
+ *        hysteresis zone does not raise an event on every sample.
+ *        Levels without a band (fault) disarm the watch so every read re-evaluates.
+ * @param level Filter level just reported (index into cp_level_state).
+ */
+static void CP_WatchLevel(uint8_t level)
+{
+    uint16_t low;
+    uint16_t high;
+
+    if (level == 0 || level > CP_LEVEL_COUNT) {
+        ADC_CpWatch_Disarm();
+        cp_watched_state = CP_STATE_UNKNOWN;
+        return;
+    }
+
+    // Thresholds are defined at nominal VDD; the watchdog compares uncompensated results
+    low = ADC_Vdd_Uncompensate(cp_level_thresholds[level - 1] - CP_FILTER_HYSTERESIS);
+    if (level < CP_LEVEL_COUNT) {
+        high = ADC_Vdd_Uncompensate(cp_level_thresholds[level] + CP_FILTER_HYSTERESIS) - 1;
+    } else {
+        high = CP_RAW_MAX;
+    }
+    ADC_CpWatch_Arm(low, high);
+    cp_watched_state = cp_level_state[level];
+}
 
 // --- Initialization ---
 
@@ -40,6 +101,15 @@ void CP_Signal_Init(void)
     }
     PWM_Start(); // Start the PWM output
 
+    // Median + IIR + hysteresis on every CP high plateau sample, run by the ADC interrupt
+    ADC_Filter_Init(&cp_filter, CP_FILTER_MEDIAN_LEN, CP_FILTER_IIR_SHIFT,
+                    cp_level_thresholds, CP_LEVEL_COUNT, CP_FILTER_HYSTERESIS);
+    ADC_Scan_AttachFilter(ADC_SCAN_SLOT_CP, &cp_filter, true);
+
+    // Sample CP in the middle of the high and the low plateau instead of at random phase
+    PWM_EnableAdcSync(true);
+    ADC_Scan_SetPwmSync(true);
+
     // 2. Configure ADC Input Pin (e.g., PA1)
     // Assuming RCC clock for GPIOA and ADC is enabled elsewhere
     // CP_ADC_GPIO_CLK_ENABLE(); // Clock should be enabled centrally
@@ -129,43 +199,113 @@ CP_State_t CP_ReadState(void)
     // State E (0V):   CP_mV ~ 0V => Raw ~ 0. Range: < 600
     // State F (-12V): CP_mV ~ -12000mV (Clamped by diode to ~0V) => Raw ~ 0. Range: < 600
 
-    const uint16_t THRESHOLD_A_MIN = 3600; // Min raw value for State A
-    const uint16_t THRESHOLD_B_MIN = 2600; // Min raw value for State B
-    const uint16_t THRESHOLD_C_MIN = 1600; // Min raw value for State C
-    const uint16_t THRESHOLD_D_MIN = 600;  // Min raw value for State D
-    const uint16_t ADC_ERROR_VALUE = 0xFFFF; // Value returned by ADC_Read_Channel_Raw on timeout
+    const uint16_t ADC_ERROR_VALUE = 0xFFFF; // Value returned by ADC_Read_Channel_Raw on timeout / empty scan slot
 
-    uint32_t adc_sum = 0;
-    uint16_t adc_raw_single = 0;
     uint16_t adc_raw_avg = 0;
-    int i;
+    uint16_t adc_raw_low = 0;
+    uint32_t low_count = 0;
+    uint8_t level;
+    CP_State_t state;
+
+    if (ADC_Scan_IsRunning()) {
+        // Diode / -12V check on every new low plateau sample (no low plateau at 100% duty)
+        low_count = ADC_Scan_GetSampleCount(ADC_SCAN_SLOT_CP_LOW);
+        if (PWM_Get_DutyCycle() < 100 && low_count != cp_low_checked_count) {
+            cp_low_checked_count = low_count;
+            adc_raw_low = ADC_Scan_GetRaw(ADC_SCAN_SLOT_CP_LOW);
+            if (adc_raw_low != ADC_ERROR_VALUE && ADC_Vdd_Compensate(adc_raw_low) > CP_LOW_PLATEAU_MAX_RAW) {
+                CP_WatchLevel(0);
+                ErrorHandler_Handle(ERROR_CP_VOLTAGE_INVALID, "CP_ReadState", __LINE__);
+                return CP_STATE_FAULT;
+            }
+        }
 
-    // Read multiple samples and average
-    for (i = 0; i < CP_ADC_AVG_SAMPLES; i++) {
-        adc_raw_single = ADC_Read_Channel_Raw(ADC_ExInputCH1); // Read CP channel
+        // The ADC window watchdog guards the last state's band; nothing to evaluate until it is left
+        if (cp_watched_state != CP_STATE_UNKNOWN && ADC_CpWatch_IsArmed() && !ADC_CpWatch_Triggered()) {
+            return cp_watched_state;
+        }
 
-        // Check for ADC read error (timeout) on any sample
-        if (adc_raw_single == ADC_ERROR_VALUE) {
-            // Error already reported by ADC_Read_Channel_Raw via ErrorHandler_Handle
+        // PWM synchronised high plateau samples, already median/IIR filtered and classified in the ISR
+        if (!ADC_Filter_IsPrimed(&cp_filter)) {
+            return CP_STATE_FAULT; // Not converted yet
+        }
+        level = ADC_Filter_GetLevel(&cp_filter);
+    } else {
+        // One counted hardware burst (single configuration, EOA interrupt) instead of 8 polled reads
+        adc_raw_avg = ADC_Read_Channel_Average(ADC_ExInputCH1, CP_ADC_AVG_LOG2);
+        if (adc_raw_avg == ADC_ERROR_VALUE) {
+            // Error already reported by the ADC driver via ErrorHandler_Handle
             return CP_STATE_FAULT; // Return fault state immediately
         }
-        adc_sum += adc_raw_single;
+
+        // The CP divider does not follow VDD: scale the reading to the nominal 3300mV reference
+        adc_raw_avg = ADC_Vdd_Compensate(adc_raw_avg);
+        level = ADC_Filter_LevelOf(cp_level_thresholds, CP_LEVEL_COUNT, adc_raw_avg);
     }
-    adc_raw_avg = (uint16_t)(adc_sum / CP_ADC_AVG_SAMPLES);
-
-    // Determine state based on the *average* thresholds
-    if (adc_raw_avg >= THRESHOLD_A_MIN) {
-        return CP_STATE_A_12V;
-    } else if (adc_raw_avg >= THRESHOLD_B_MIN) {
-        return CP_STATE_B_9V;
-    } else if (adc_raw_avg >= THRESHOLD_C_MIN) {
-        return CP_STATE_C_6V;
-    } else if (adc_raw_avg >= THRESHOLD_D_MIN) {
-        return CP_STATE_D_3V;
-    } else {
+
+    // Determine state from the level (count of thresholds below the reading)
+    state = cp_level_state[level];
+    if (state == CP_STATE_FAULT) {
         // Treat values below D threshold as E (0V), F (-12V clamped), or other fault
         // Report this potentially invalid voltage level
         ErrorHandler_Handle(ERROR_CP_VOLTAGE_INVALID, "CP_ReadState", __LINE__);
-        return CP_STATE_FAULT; // Return general fault state
     }
+
+    // Re-arm the window around the new state (background scan only)
+    if (ADC_Scan_IsRunning()) {
+        CP_WatchLevel(level);
+    }
+    return state;
+}
+
+/**
+ * @brief Checks whether CP left the voltage band of the last reported state.
+ *        Lets the main loop run the state machine right away instead of at the next tick.
+ * @return true if CP_ReadState() would re-evaluate the state.
+ */
+bool CP_StateChangePending(void)
+{
+    return ADC_CpWatch_Triggered();
+}
+
+/**
+ * @brief Stops watching the band of the last reported state.
+ *        For use while the EVSE itself holds CP away from that state (e.g., State F after
+ *        a fast trip), so the latched window event does not keep CP_StateChangePending() true.
+ *        The next CP_ReadState() re-evaluates the level and re-arms the watch.
+ */
+void CP_StopWatch(void)
+{
+    CP_WatchLevel(0);
+}
+
+/**
+ * @brief Gets the CP voltage of the high and the low PWM plateau.
+ * @param high_mv Output: high plateau voltage in mV.
+ * @param low_mv Output: low plateau voltage in mV (0 while the -12V level is clamped).
+ * @return true if both plateaus have been sampled, false otherwise (e.g., 100% duty, scan stopped).
+ */
+bool CP_GetPlateauVoltages(uint16_t *high_mv, uint16_t *low_mv)
+{
+    uint16_t high_raw;
+    uint16_t low_raw;
+
+    if (high_mv == NULL || low_mv == NULL) {
+        ErrorHandler_Handle(ERROR_INVALID_PARAM, "CP_GetPlateauVoltages", __LINE__);
+        return false;
+    }
+
+    if (!ADC_Scan_IsRunning() || PWM_Get_DutyCycle() >= 100) {
+        return false;
+    }
+
+    high_raw = ADC_Scan_GetRaw(ADC_SCAN_SLOT_CP);
+    low_raw = ADC_Scan_GetRaw(ADC_SCAN_SLOT_CP_LOW);
+    if (high_raw == 0xFFFF || low_raw == 0xFFFF) {
+        return false;
+    }
+
+    *high_mv = CP_RAW_TO_MV(ADC_Vdd_Compensate(high_raw));
+    *low_mv = CP_RAW_TO_MV(ADC_Vdd_Compensate(low_raw));
+    return true;
 }
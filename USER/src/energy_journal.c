@@ -0,0 +1,227 @@
+#include "energy_journal.h"
+#include "config.h"          // For JOURNAL_PAGE_A / JOURNAL_PAGE_B
+#include "cw32f003_flash.h"
+#include "cw32f003_crc.h"
+#include "cw32f003_rcc.h"
+#include "log.h"             // Tokenized logging
+#include <stddef.h>          // For NULL, offsetof
+#include <string.h>          // For memcpy
+
+// --- Defines ---
+#define JOURNAL_PAGE_SIZE        512
+#define JOURNAL_RECORD_SIZE      sizeof(Journal_Record_t)
+#define JOURNAL_RECORDS_PER_PAGE (JOURNAL_PAGE_SIZE / JOURNAL_RECORD_SIZE)
+// FLASH_WirteBytes() rejects any write that reaches 0x4FFF, so the last slot of page B
+// (0x4FF0-0x4FFF) can never get its CRC programmed and is left unused
+#define JOURNAL_SLOT_COUNT       (2 * JOURNAL_RECORDS_PER_PAGE - 1)
+#define JOURNAL_CRC_LEN          offsetof(Journal_Record_t, crc)
+#define JOURNAL_SEQ_ERASED       0xFFFFFFFFUL
+#define JOURNAL_WRITE_CHUNK      4   // Bytes programmed per Journal_Poll() step
+#define JOURNAL_MAX_RETRIES      2   // Slots tried per record before it is dropped
+
+typedef enum {
+    JOURNAL_IDLE,
+    JOURNAL_ERASE,   // Next step erases the page that journal_slot opens
+    JOURNAL_WRITE    // Next steps program journal_staged into journal_slot
+} Journal_Phase_t;
+
+// --- Private Variables ---
+static Journal_Record_t journal_staged;      // Record being written (sequence/crc filled in)
+static Journal_Record_t journal_queued;      // Next record, waiting for the current write
+static bool journal_queued_valid = false;
+static Journal_Phase_t journal_phase = JOURNAL_IDLE;
+static uint16_t journal_slot = 0;            // Slot the next record goes to
+static uint8_t journal_write_offset = 0;     // Bytes of journal_staged already programmed
+static uint32_t journal_next_seq = 0;
+static uint8_t journal_retries = 0;          // Failed attempts for the staged record
+
+// --- Private Helpers ---
+
+/**
+ * @brief Gets the flash page number holding a slot.
+ */
+static uint8_t Journal_SlotPage(uint16_t slot)
+{
+    return (slot < JOURNAL_RECORDS_PER_PAGE) ? JOURNAL_PAGE_A : JOURNAL_PAGE_B;
+}
+
+/**
+ * @brief Gets the flash address of a slot.
+ */
+static uint32_t Journal_SlotAddr(uint16_t slot)
+{
+    return (uint32_t)Journal_SlotPage(slot) * JOURNAL_PAGE_SIZE +
+           (uint32_t)(slot % JOURNAL_RECORDS_PER_PAGE) * JOURNAL_RECORD_SIZE;
+}
+
+/**
+ * @brief Calculates the record CRC with the hardware CRC unit.
+ */
+static uint16_t Journal_Crc(const Journal_Record_t *record)
+{
+    return CRC16_Calc_8bit(CRC16_CCITTFALSE, (uint8_t *)record, JOURNAL_CRC_LEN);
+}
+
+/**
+ * @brief Checks whether a slot is still erased (all 0xFF).
+ */
+static bool Journal_SlotIsBlank(uint16_t slot)
+{
+    const uint8_t *p = (const uint8_t *)Journal_SlotAddr(slot);
+    for (uint8_t i = 0; i < JOURNAL_RECORD_SIZE; i++) {
+        if (p[i] != 0xFF) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Moves a queued record into the write stage and selects the first step.
+ */
+static void Journal_Stage(const Journal_Record_t *record)
+{
+    journal_staged = *record;
+    journal_staged.sequence = journal_next_seq++;
+    journal_staged.crc = Journal_Crc(&journal_staged);
+    journal_write_offset = 0;
+    // Erase only when a record opens a page (the other page then still holds the newest data)
+    journal_phase = (journal_slot % JOURNAL_RECORDS_PER_PAGE == 0) ? JOURNAL_ERASE : JOURNAL_WRITE;
+}
+
+// --- Public Functions ---
+
+/**
+ * @brief Scans the journal pages for the newest valid record.
+ */
+bool Journal_Init(Journal_Record_t *latest)
+{
+    Journal_Record_t record;
+    bool found = false;
+    uint16_t newest_slot = 0;
+    uint32_t newest_seq = 0;
+
+    __RCC_CRC_CLK_ENABLE();
+
+    journal_phase = JOURNAL_IDLE;
+    journal_queued_valid = false;
+
+    for (uint16_t slot = 0; slot < JOURNAL_SLOT_COUNT; slot++) {
+        memcpy(&record, (const void *)Journal_SlotAddr(slot), JOURNAL_RECORD_SIZE);
+        if (record.sequence == JOURNAL_SEQ_ERASED || record.crc != Journal_Crc(&record)) {
+            continue; // Blank or torn
+        }
+        if (!found || record.sequence > newest_seq) {
+            found = true;
+            newest_seq = record.sequence;
+            newest_slot = slot;
+            if (latest != NULL) {
+                *latest = record;
+            }
+        }
+    }
+
+    if (!found) {
+        journal_slot = 0; // Fresh journal: the first write erases page A
+        journal_next_seq = 0;
+        return false;
+    }
+
+    // Continue after the newest record, skipping slots left dirty by an interrupted write
+    journal_next_seq = newest_seq + 1;
+    journal_slot = newest_slot;
+    do {
+        journal_slot = (journal_slot + 1) % JOURNAL_SLOT_COUNT;
+    } while (journal_slot % JOURNAL_RECORDS_PER_PAGE != 0 && !Journal_SlotIsBlank(journal_slot));
+
+    return true;
+}
+
+/**
+ * @brief Queues a record for writing.
+ */
+void Journal_Append(const Journal_Record_t *record)
+{
+    if (record == NULL) {
+        return;
+    }
+    if (journal_phase == JOURNAL_IDLE) {
+        journal_queued_valid = false; // Anything left from a dropped write is older than this
+        journal_retries = 0;
+        Journal_Stage(record);
+    } else {
+        journal_queued = *record; // Newer data supersedes an older queued record
+        journal_queued_valid = true;
+    }
+}
+
+/**
+ * @brief Runs one bounded step of a pending write.
+ */
+void Journal_Poll(void)
+{
+    uint8_t status;
+    bool erasing = (journal_phase == JOURNAL_ERASE);
+    uint32_t page_addr = (uint32_t)Journal_SlotPage(journal_slot) * JOURNAL_PAGE_SIZE;
+
+    if (journal_phase == JOURNAL_IDLE) {
+        return;
+    }
+
+    FLASH_UnlockPages(page_addr, page_addr + JOURNAL_PAGE_SIZE - 1);
+
+    if (erasing) {
+        status = FLASH_ErasePage(Journal_SlotPage(journal_slot));
+        journal_phase = JOURNAL_WRITE;
+    } else {
+        uint8_t len = JOURNAL_RECORD_SIZE - journal_write_offset;
+        if (len > JOURNAL_WRITE_CHUNK) {
+            len = JOURNAL_WRITE_CHUNK;
+        }
+        status = FLASH_WirteBytes(Journal_SlotAddr(journal_slot) + journal_write_offset,
+                                  (uint8_t *)&journal_staged + journal_write_offset, len);
+        journal_write_offset += len;
+    }
+
+    FLASH_LockPages(page_addr, page_addr + JOURNAL_PAGE_SIZE - 1);
+
+    if (status != FLASH_FLAG_OK) { // Error flags, or FLASH_ERROR_ADDR from the library checks
+        LOG2(JOURNAL_FLASH_ERROR, status, journal_slot);
+        if (erasing) {
+            // The page could not be erased. The other page holds the newest record, so it is
+            // left intact: drop this record and keep journal_slot at the start of the failed
+            // page, so the next Journal_Append() retries the erase.
+            journal_next_seq--;
+            journal_queued_valid = false;
+            journal_phase = JOURNAL_IDLE;
+            return;
+        }
+        journal_slot = (journal_slot + 1) % JOURNAL_SLOT_COUNT; // Abandon the slot
+        if (++journal_retries > JOURNAL_MAX_RETRIES) {
+            journal_phase = JOURNAL_IDLE; // Drop the record; the next Journal_Append() tries again
+            return;
+        }
+        journal_next_seq--;
+        Journal_Stage(&journal_staged);
+        return;
+    }
+
+    if (!erasing && journal_write_offset >= JOURNAL_RECORD_SIZE) {
+        // Record complete (CRC programmed last)
+        journal_slot = (journal_slot + 1) % JOURNAL_SLOT_COUNT;
+        journal_phase = JOURNAL_IDLE;
+        if (journal_queued_valid) {
+            journal_queued_valid = false;
+            journal_retries = 0;
+            Journal_Stage(&journal_queued);
+        }
+    }
+}
+
+/**
+ * @brief Checks whether a record is queued or being written.
+ */
+bool Journal_IsBusy(void)
+{
+    return journal_phase != JOURNAL_IDLE;
+}
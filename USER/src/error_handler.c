@@ -1,6 +1,6 @@
 #include "error_handler.h"
 #include "uart_driver.h" // For printing error messages to debug UART
-#include <stdio.h>       // For snprintf or printf
+#include "log.h"         // Tokenized logging (safe from ISRs, never waits for the UART)
 
 // --- Private Variables ---
 
@@ -19,9 +19,9 @@ void ErrorHandler_Handle(ErrorCode_t code, const char* module_name, uint32_t lin
     // Store the error code
     last_error_code = code;
 
-    // Log the error to the debug UART (UART1)
-    // Ensure printf is working correctly via uart_driver.c
-    printf("ERROR: Code %d in %s at line %u\r\n", (int)code, module_name, line_number);
+    // Log the error (code and line; the module name stays on the target to keep records small)
+    (void)module_name;
+    LOG2(ERR_REPORTED, code, line_number);
 
     // --- Add specific actions based on error code ---
     switch (code)
@@ -30,7 +30,7 @@ void ErrorHandler_Handle(ErrorCode_t code, const char* module_name, uint32_t lin
         case ERROR_UART1_INIT_FAILED:
         case ERROR_SYSTICK_INIT_FAILED:
             // Critical failures - perhaps halt or enter safe mode
-            printf("FATAL: Critical peripheral init failed. Halting.\r\n");
+            UART_WriteString("FATAL: Critical peripheral init failed. Halting.\r\n");
             // Optional: Blink an LED rapidly
             // Optional: Disable interrupts
              __disable_irq();
@@ -42,7 +42,7 @@ void ErrorHandler_Handle(ErrorCode_t code, const char* module_name, uint32_t lin
         case ERROR_OVERCURRENT:
         case ERROR_OVERVOLTAGE:
         case ERROR_GFCI_FAULT: // If implemented
-            printf("SAFETY CRITICAL ERROR: Opening contactor.\r\n");
+            LOG1(ERR_SAFETY, code);
             // TODO: Call function to safely open the contactor
             // Contactor_Open(); // Example
             // TODO: Stop CP PWM signal
@@ -55,7 +55,7 @@ void ErrorHandler_Handle(ErrorCode_t code, const char* module_name, uint32_t lin
         case ERROR_HLW_CHECKSUM:
         case ERROR_CP_VOLTAGE_INVALID:
         case ERROR_PP_RESISTANCE_INVALID:
-            // Logged via printf above.
+            // Logged via LOG2(ERR_REPORTED) above.
             // TODO: Update UI to indicate a non-critical error/warning
             // UI_Display_ShowWarning(code); // Example
             // State machine should handle transitions based on these errors.
@@ -64,13 +64,13 @@ void ErrorHandler_Handle(ErrorCode_t code, const char* module_name, uint32_t lin
         // --- Buffer Full / Timeouts (Might be warnings or recoverable) ---
         case ERROR_BUFFER_FULL:
         case ERROR_TIMEOUT:
-            // Logged via printf above.
+            // Logged via LOG2(ERR_REPORTED) above.
             // These might not require immediate action but indicate performance issues.
             break;
 
         // --- Default for other errors ---
         default:
-            // Logged via printf above.
+            // Logged via LOG2(ERR_REPORTED) above.
             // Consider if specific UI update or action is needed.
             break;
     }
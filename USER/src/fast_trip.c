@@ -0,0 +1,117 @@
+#include "fast_trip.h"
+#include "config.h"            // For FAST_TRIP_* pin and threshold definitions
+#include "contactor_control.h" // Trip opens the contactor from the ISR
+#include "pwm_driver.h"        // Trip drives CP to its fault level
+#include "cw32f003_vc.h"
+#include "cw32f003_gpio.h"
+#include "cw32f003_rcc.h"
+#include "cw32f003_systick.h"  // For GetTick()
+
+// --- Private Variables ---
+static volatile bool fast_trip_tripped = false; // Latched by the ISR, cleared by FastTrip_Rearm()
+static volatile uint32_t fast_trip_tick = 0;    // GetTick() at the trip
+
+// --- Public Functions ---
+
+/**
+ * @brief Initializes the VC1 fast-trip channel.
+ */
+void FastTrip_Init(void)
+{
+#if FAST_TRIP_ENABLE
+    GPIO_InitTypeDef GPIO_InitStruct;
+    VC_InitTypeDef VC_InitStruct;
+    VC_DivTypeDef VC_DivStruct;
+    VC_BlankTypeDef VC_BlankStruct;
+
+    fast_trip_tripped = false;
+
+    __RCC_VC_CLK_ENABLE();
+    FAST_TRIP_GPIO_CLK_ENABLE();
+
+    // Sense input in analog mode
+    GPIO_InitStruct.Pins = FAST_TRIP_GPIO_PIN;
+    GPIO_InitStruct.Mode = GPIO_MODE_ANALOG;
+    GPIO_Init(FAST_TRIP_GPIO_PORT, &GPIO_InitStruct);
+
+    // Threshold from the 6-bit VDD divider
+    VC_DivStruct.VC_DivEn = VC_Div_Enable;
+    VC_DivStruct.VC_DivVref = VC_DivVref_VDD;
+    VC_DivStruct.VC_DivValue = FAST_TRIP_DIV_VALUE;
+    VC1VC2_DIVInit(&VC_DivStruct);
+
+    // Fast response, a little hysteresis, short PCLK filter against single-sample spikes
+    VC_InitStruct.VC_InputP = FAST_TRIP_VC_INPUT_P;
+    VC_InitStruct.VC_InputN = VC_InputN_DivOut;
+    VC_InitStruct.VC_Hys = VC_Hys_20mV;
+    VC_InitStruct.VC_Resp = VC_Resp_High;
+    VC_InitStruct.VC_FilterEn = VC_Filter_Enable;
+    VC_InitStruct.VC_FilterClk = VC_FltClk_PCLK;
+    VC_InitStruct.VC_FilterTime = VC_FltTime_15Clk;
+    VC_InitStruct.VC_Window = VC_Window_Disable;
+    VC_InitStruct.VC_Polarity = VC_Polarity_High;
+    VC1_ChannelInit(&VC_InitStruct);
+
+    // Ignore the comparator briefly after each CP PWM edge (ATIM CH2B) to mask switching noise
+    VC_BlankStruct.VC_BlankFlt = VC_BlankFlt_32Clk;
+    VC_BlankStruct.VC_BlankCh1B = VC_BlankCh1B_Disable;
+    VC_BlankStruct.VC_BlankCh2B = VC_BlankCh2B_Enable;
+    VC_BlankStruct.VC_BlankCh3B = VC_BlankCh3B_Disable;
+    VC1_BlankCfg(&VC_BlankStruct);
+
+    VC1_EnableChannel();
+    VC1_ClearIrq();
+    VC1_ITConfig(VC_IT_RISE, ENABLE);
+    VC1_EnableIrq(FAST_TRIP_IRQ_PRIORITY);
+#endif
+}
+
+/**
+ * @brief Re-arms the comparator after a trip has been handled.
+ */
+bool FastTrip_Rearm(void)
+{
+#if FAST_TRIP_ENABLE
+    if (!fast_trip_tripped) {
+        return true; // Nothing latched
+    }
+    if ((GetTick() - fast_trip_tick) < FAST_TRIP_CP_HOLD_MS) {
+        return false; // CP stays at the fault level long enough for the EV to see it
+    }
+    if (VC1_GetFlagStatus(VC_FLAG_FLTV) != RESET) {
+        return false; // Fault input still active
+    }
+    __disable_irq(); // Enter critical section
+    fast_trip_tripped = false;
+    VC1_ClearIrq();
+    VC1_ITConfig(VC_IT_RISE, ENABLE);
+    __enable_irq();  // Exit critical section
+    PWM_ReleaseOutput(); // CP follows the duty set by the state machine again
+#endif
+    return true;
+}
+
+/**
+ * @brief Checks whether the comparator has tripped since the last re-arm.
+ */
+bool FastTrip_IsTripped(void)
+{
+    return fast_trip_tripped;
+}
+
+/**
+ * @brief Handles the comparator interrupt: contactor first, then CP, then the event.
+ */
+void FastTrip_Handle_IRQ(void)
+{
+#if FAST_TRIP_ENABLE
+    if (VC1_GetFlagStatus(VC_FLAG_INTF) != RESET) {
+        Contactor_Open();        // Time-critical: a single GPIO write
+        PWM_FORCE_OUTPUT_LOW();  // CP constant low (State F) until re-armed; duty untouched
+        VC1_ClearIrq();
+        VC1_ITConfig(VC_IT_RISE, DISABLE); // One trip per arm; the state machine re-arms
+        fast_trip_tick = GetTick();
+        fast_trip_tripped = true;          // Picked up by SM_RunStateMachine()
+    }
+#endif
+}
@@ -0,0 +1,144 @@
+#include "fmt.h"
+
+// Digits are found by repeated subtraction of powers of ten: the M0+ has no divide
+// instruction, and a library division per digit costs far more than at most 9 subtractions.
+static const uint32_t fmt_pow10[FMT_U32_LEN] = {
+    1000000000u, 100000000u, 10000000u, 1000000u, 100000u,
+    10000u, 1000u, 100u, 10u, 1u
+};
+
+static const char fmt_hex_digits[16] = {
+    '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'A', 'B', 'C', 'D', 'E', 'F'
+};
+
+/**
+ * @brief Formats an unsigned decimal number.
+ */
+uint8_t Fmt_U32(char *buf, uint32_t value)
+{
+    uint8_t i = 0;
+    uint8_t len = 0;
+
+    // Skip leading zeros (the last power, 1, always yields a digit)
+    while (i < FMT_U32_LEN - 1 && value < fmt_pow10[i]) {
+        i++;
+    }
+    for (; i < FMT_U32_LEN; i++) {
+        uint32_t p = fmt_pow10[i];
+        char digit = '0';
+        while (value >= p) {
+            value -= p;
+            digit++;
+        }
+        buf[len++] = digit;
+    }
+    buf[len] = '\0';
+    return len;
+}
+
+/**
+ * @brief Formats a signed decimal number.
+ */
+uint8_t Fmt_I32(char *buf, int32_t value)
+{
+    if (value < 0) {
+        buf[0] = '-';
+        return 1 + Fmt_U32(buf + 1, 0u - (uint32_t)value); // Also right for INT32_MIN
+    }
+    return Fmt_U32(buf, (uint32_t)value);
+}
+
+/**
+ * @brief Formats a fixed-point number.
+ */
+uint8_t Fmt_Fixed(char *buf, int32_t value, uint8_t decimals)
+{
+    char digits[FMT_U32_LEN + 1];
+    uint8_t ndigits, int_digits, len = 0, i;
+
+    if (decimals > FMT_U32_LEN - 1) {
+        decimals = FMT_U32_LEN - 1;
+    }
+    if (value < 0) {
+        buf[len++] = '-';
+        ndigits = Fmt_U32(digits, 0u - (uint32_t)value);
+    } else {
+        ndigits = Fmt_U32(digits, (uint32_t)value);
+    }
+    int_digits = (ndigits > decimals) ? (uint8_t)(ndigits - decimals) : 0;
+
+    // Integer part, "0" below one
+    if (int_digits == 0) {
+        buf[len++] = '0';
+    }
+    for (i = 0; i < int_digits; i++) {
+        buf[len++] = digits[i];
+    }
+
+    // Fraction, zero-padded after the point ("0.05")
+    if (decimals != 0) {
+        buf[len++] = '.';
+        for (i = ndigits; i < decimals; i++) {
+            buf[len++] = '0';
+        }
+        for (i = int_digits; i < ndigits; i++) {
+            buf[len++] = digits[i];
+        }
+    }
+    buf[len] = '\0';
+    return len;
+}
+
+/**
+ * @brief Formats an uppercase hexadecimal number.
+ */
+uint8_t Fmt_Hex(char *buf, uint32_t value, uint8_t digits)
+{
+    uint8_t i;
+
+    if (digits == 0) {
+        digits = 1;
+    } else if (digits > FMT_HEX_LEN) {
+        digits = FMT_HEX_LEN;
+    }
+    for (i = digits; i > 0; i--) {
+        buf[i - 1] = fmt_hex_digits[value & 0x0Fu];
+        value >>= 4;
+    }
+    buf[digits] = '\0';
+    return digits;
+}
+
+/**
+ * @brief Copies a string.
+ */
+uint8_t Fmt_Str(char *buf, const char *str)
+{
+    uint8_t len = 0;
+    while (str[len] != '\0') {
+        buf[len] = str[len];
+        len++;
+    }
+    buf[len] = '\0';
+    return len;
+}
+
+/**
+ * @brief Right-aligns a formatted string in place.
+ */
+uint8_t Fmt_AlignRight(char *buf, uint8_t len, uint8_t width)
+{
+    uint8_t pad, i;
+
+    if (len >= width) {
+        return len;
+    }
+    pad = width - len;
+    for (i = len + 1; i > 0; i--) { // Move the text and its NUL, last byte first
+        buf[i - 1 + pad] = buf[i - 1];
+    }
+    for (i = 0; i < pad; i++) {
+        buf[i] = ' ';
+    }
+    return width;
+}
@@ -4,81 +4,17 @@
 #include "cw32f003_gpio.h"
 #include "cw32f003_uart.h"
 #include "error_handler.h" // Include the error handler
+#include "ring_buffer.h"   // SPSC ring shared with the debug UART driver
 #include <stdio.h> // Keep for potential debugging printf inside driver
 #include <stdbool.h>
 #include <string.h>
 
-// Static ring buffer instance for RX
-static HLW_RingBuffer_t hlw_rx_buffer;
+// RX ring: filled by the UART2 ISR, drained by the main loop
+static volatile uint8_t hlw_rx_storage[HLW_UART_BUFFER_SIZE];
+static RingBuffer_t hlw_rx_buffer;
 
-// --- Ring Buffer Helper Functions ---
-
-/**
- * @brief Initializes the HLW ring buffer.
- * @param rb Pointer to the HLW_RingBuffer_t structure.
- */
-static void HLW_RingBuffer_Init(HLW_RingBuffer_t *rb) {
-    rb->head = 0;
-    rb->tail = 0;
-    rb->count = 0;
-}
-
-/**
- * @brief Checks if the HLW ring buffer is full.
- * @param rb Pointer to the HLW_RingBuffer_t structure.
- * @return true if full, false otherwise.
- */
-static bool HLW_RingBuffer_IsFull(const HLW_RingBuffer_t *rb) {
-    return rb->count >= HLW_UART_BUFFER_SIZE;
-}
-
-/**
- * @brief Checks if the HLW ring buffer is empty.
- * @param rb Pointer to the HLW_RingBuffer_t structure.
- * @return true if empty, false otherwise.
- */
-static bool HLW_RingBuffer_IsEmpty(const HLW_RingBuffer_t *rb) {
-    return rb->count == 0;
-}
-
-/**
- * @brief Adds a byte to the HLW ring buffer.
- * @param rb Pointer to the HLW_RingBuffer_t structure.
- * @param data The byte to add.
- * @return true if successful, false if buffer is full.
- */
-static bool HLW_RingBuffer_Put(HLW_RingBuffer_t *rb, uint8_t data) {
-    if (HLW_RingBuffer_IsFull(rb)) {
-        // Consider adding overflow handling/flag here
-        return false; // Buffer full
-    }
-    rb->buffer[rb->head] = data;
-    rb->head = (rb->head + 1) % HLW_UART_BUFFER_SIZE;
-    __disable_irq(); // Enter critical section
-    rb->count++;
-    __enable_irq();  // Exit critical section
-    return true;
-}
-
-/**
- * @brief Retrieves a byte from the HLW ring buffer.
- * @param rb Pointer to the HLW_RingBuffer_t structure.
- * @param data Pointer to store the retrieved byte.
- * @return true if successful, false if buffer is empty.
- */
-static bool HLW_RingBuffer_Get(HLW_RingBuffer_t *rb, uint8_t *data) {
-    if (HLW_RingBuffer_IsEmpty(rb)) {
-        return false; // Buffer empty
-    }
-    *data = rb->buffer[rb->tail];
-    rb->tail = (rb->tail + 1) % HLW_UART_BUFFER_SIZE;
-    __disable_irq(); // Enter critical section
-    rb->count--;
-    __enable_irq();  // Exit critical section
-    return true;
-}
-
-// --- End Ring Buffer Helper Functions ---
+// Optional ISR byte sink; when set, bytes are handed over instead of queued
+static volatile HLW_UART_RxHandler_t hlw_rx_handler = NULL;
 
 
 /**
@@ -92,7 +28,9 @@ bool HLW_UART_Init(uint32_t baudRate)
     GPIO_InitTypeDef GPIO_InitStructure;
 
     // Initialize RX ring buffer
-    HLW_RingBuffer_Init(&hlw_rx_buffer);
+    if (!RingBuffer_Init(&hlw_rx_buffer, hlw_rx_storage, HLW_UART_BUFFER_SIZE)) {
+        return false; // Buffer size is not a power of two
+    }
 
     // Enable peripheral clocks using macros from config.h
     // Assuming HSI is enabled elsewhere (e.g., main System_Init)
@@ -145,7 +83,7 @@ bool HLW_UART_Init(uint32_t baudRate)
  */
 int16_t HLW_UART_Read(void) {
     uint8_t data;
-    if (HLW_RingBuffer_Get(&hlw_rx_buffer, &data)) {
+    if (RingBuffer_Get(&hlw_rx_buffer, &data)) {
         return (int16_t)data;
     } else {
         return -1; // No data available
@@ -157,7 +95,15 @@ int16_t HLW_UART_Read(void) {
  * @return true if data is available, false otherwise.
  */
 bool HLW_UART_DataAvailable(void) {
-    return !HLW_RingBuffer_IsEmpty(&hlw_rx_buffer);
+    return !RingBuffer_IsEmpty(&hlw_rx_buffer);
+}
+
+/**
+ * @brief Registers a byte sink that consumes received bytes directly in ISR context.
+ * @param handler Function called for each received byte, or NULL to use the RX ring buffer.
+ */
+void HLW_UART_SetRxHandler(HLW_UART_RxHandler_t handler) {
+    hlw_rx_handler = handler; // Single pointer write, atomic on Cortex-M0+
 }
 
 // --- End Public Non-Blocking Functions ---
@@ -173,8 +119,11 @@ void HLW_UART_Handle_RC(void) {
     if (USART_GetFlagStatus(HLW_USART_PERIPH, USART_FLAG_RC) != RESET) { // Use peripheral macro for UART2
         uint8_t data = USART_ReceiveData_8bit(HLW_USART_PERIPH); // Use peripheral macro for UART2
 
-        // Attempt to put data into buffer.
-        if (!HLW_RingBuffer_Put(&hlw_rx_buffer, data)) {
+        HLW_UART_RxHandler_t handler = hlw_rx_handler;
+        if (handler != NULL) {
+            // Hand the byte straight to the registered consumer (frame assembler)
+            handler(data);
+        } else if (!RingBuffer_Put(&hlw_rx_buffer, data)) {
             // Buffer is full, data is lost. Report the error.
             // WARNING: Calling complex handlers from ISR can be problematic.
             // Consider setting a flag for the main loop instead in critical systems.
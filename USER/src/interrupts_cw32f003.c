@@ -24,6 +24,10 @@
 
 #include "../inc/cw32f003_atim.h"
 #include "../inc/hlw_uart_driver.h" // Include the HLW UART driver header
+#include "../inc/fast_trip.h"       // Include the comparator fast-trip header
+#include "../inc/adc_driver.h"      // Include the ADC driver header (background scan)
+#include "../inc/low_power.h"       // Include the idle manager header (AWT wake-up)
+#include "../inc/spi_oled_driver.h" // Include the OLED driver header (SPI transfer queue)
 /* USER CODE END Includes */
 
 
@@ -58,9 +62,7 @@
 
 /* External variables --------------------------------------------------------*/
 /* USER CODE BEGIN EV */
-extern volatile bool flag_run_state_machine; // Flag defined in main.c
-extern volatile bool flag_update_display;    // Flag defined in main.c
-// Add extern declarations for other flags if needed
+// Task releases are derived from GetTick() by the scheduler (scheduler.c)
 /* USER CODE END EV */
 
 /******************************************************************************/
@@ -119,28 +121,8 @@ void SysTick_Handler(void)
   /* USER CODE BEGIN SysTick_IRQn */
   uwTick++; // Increment the system tick counter (used by HAL_Delay, etc.)
 
-  // Task Scheduling Counters (assuming 1ms SysTick interval)
-  static uint32_t counter_10ms = 0;
-  static uint32_t counter_100ms = 0;
-  // Add other counters here
-
-  // --- 10ms Tasks ---
-  counter_10ms++;
-  if (counter_10ms >= 10) // Every 10ms
-  {
-    counter_10ms = 0;
-    flag_run_state_machine = true; // Set flag for state machine execution
-    // Add other 10ms tasks flags here (e.g., button debouncing)
-  }
-
-  // --- 100ms Tasks ---
-  counter_100ms++;
-  if (counter_100ms >= 100) // Every 100ms
-  {
-    counter_100ms = 0;
-    flag_update_display = true; // Set flag for display update
-    // Add other 100ms tasks flags here
-  }
+  // --- 1ms Tasks ---
+  ADC_Scan_Trigger(); // Kick the next CP/PP scan (no-op while the previous one runs)
 
   // Add other interval checks here (e.g., 1ms for AC sampling trigger)
 
@@ -233,6 +215,9 @@ void ADC_IRQHandler(void)
 {
   /* USER CODE BEGIN */
 
+  // Background scan engine: stores results and chains the next sequence
+  ADC_Driver_Handle_IRQ();
+
   /* USER CODE END */
 }
 
@@ -255,6 +240,7 @@ void ATIM_IRQHandler(void)
 void VC1_IRQHandler(void)
 {
   /* USER CODE BEGIN */
+  FastTrip_Handle_IRQ(); // Comparator fast-trip: opens the contactor
 
   /* USER CODE END */
 }
@@ -325,6 +311,8 @@ void I2C_IRQHandler(void)
 void SPI_IRQHandler(void)
 {
   /* USER CODE BEGIN */
+  // Transmit Empty: only enabled while the OLED transfer queue has data
+  OLED_SPI_Handle_TXE();
 
   /* USER CODE END */
 }
@@ -376,6 +364,7 @@ void UART2_IRQHandler(void)
 void AWT_IRQHandler(void)
 {
   /* USER CODE BEGIN */
+  LowPower_Handle_AWT_IRQ(); // Deep sleep wake-up timer
 
   /* USER CODE END */
 }
@@ -0,0 +1,117 @@
+#include "log.h"
+#include "ring_buffer.h"       // Log ring storage
+#include "uart_driver.h"       // Drained into the debug UART TX buffer
+#include "cw32f003_systick.h"  // For uwTick (record time stamps)
+
+// LOG_RING_SIZE must be a power of two (ring_buffer.h)
+typedef char log_ring_size_check[((LOG_RING_SIZE & (LOG_RING_SIZE - 1)) == 0) ? 1 : -1];
+
+// --- Private Variables ---
+static volatile uint8_t log_storage[LOG_RING_SIZE];
+// Statically initialised so errors reported before main() runs its init code are kept
+static RingBuffer_t log_ring = { log_storage, LOG_RING_SIZE - 1, 0, 0 }; // Producers serialised by a short critical section
+static uint16_t log_dropped_pending = 0; // Dropped since the last DROPPED record
+static uint32_t log_dropped_total = 0;
+
+// --- Private Helpers ---
+
+/**
+ * @brief Encodes a record into rec.
+ * @return Record length in bytes.
+ */
+static uint8_t Log_Encode(uint8_t *rec, uint8_t id, uint8_t nargs, uint32_t a, uint32_t b)
+{
+    uint32_t tick = uwTick;
+    uint8_t len = LOG_HEADER_LEN;
+
+    rec[0] = LOG_SYNC_BYTE;
+    rec[1] = id;
+    rec[2] = (uint8_t)tick;
+    rec[3] = (uint8_t)(tick >> 8);
+    if (nargs > 0) {
+        rec[len++] = (uint8_t)a;
+        rec[len++] = (uint8_t)(a >> 8);
+        rec[len++] = (uint8_t)(a >> 16);
+        rec[len++] = (uint8_t)(a >> 24);
+    }
+    if (nargs > 1) {
+        rec[len++] = (uint8_t)b;
+        rec[len++] = (uint8_t)(b >> 8);
+        rec[len++] = (uint8_t)(b >> 16);
+        rec[len++] = (uint8_t)(b >> 24);
+    }
+    return len;
+}
+
+// --- Public Functions ---
+
+/**
+ * @brief Queues one record.
+ */
+void Log_Write(uint8_t id, uint8_t nargs, uint32_t a, uint32_t b)
+{
+    uint8_t rec[LOG_RECORD_MAX];
+    uint8_t drop_rec[LOG_HEADER_LEN + 4];
+    uint8_t len = Log_Encode(rec, id, nargs, a, b);
+    uint16_t space;
+
+    __disable_irq(); // Enter critical section: ISRs log too
+    space = (uint16_t)(LOG_RING_SIZE - RingBuffer_Count(&log_ring));
+
+    if (log_dropped_pending != 0) {
+        // Report the gap first, so the decoder sees where records went missing
+        uint8_t drop_len = Log_Encode(drop_rec, LOG_ID_DROPPED, 1, log_dropped_pending, 0);
+        if (space >= drop_len + len) {
+            RingBuffer_PutBulk(&log_ring, drop_rec, drop_len);
+            space -= drop_len;
+            log_dropped_pending = 0;
+        } else {
+            space = 0; // Keep the order: nothing new before the DROPPED record
+        }
+    }
+
+    if (space >= len) {
+        RingBuffer_PutBulk(&log_ring, rec, len);
+    } else {
+        if (log_dropped_pending != UINT16_MAX) {
+            log_dropped_pending++;
+        }
+        log_dropped_total++;
+    }
+    __enable_irq();  // Exit critical section
+}
+
+/**
+ * @brief Moves queued records into the debug UART TX buffer, as far as it has room.
+ */
+void Log_Drain(void)
+{
+    uint8_t chunk[16];
+    uint16_t space = UART_TxSpace();
+
+    while (space > 0) {
+        uint16_t want = (space < sizeof(chunk)) ? space : sizeof(chunk);
+        uint16_t n = RingBuffer_GetBulk(&log_ring, chunk, want);
+        if (n == 0) {
+            break;
+        }
+        UART_Write(chunk, n); // Fits: the ISR only ever frees space
+        space -= n;
+    }
+}
+
+/**
+ * @brief Checks whether Log_Drain() has work it can do now.
+ */
+bool Log_Pending(void)
+{
+    return !RingBuffer_IsEmpty(&log_ring) && (UART_TxSpace() > 0);
+}
+
+/**
+ * @brief Gets the total number of records dropped because the ring was full.
+ */
+uint32_t Log_GetDropped(void)
+{
+    return log_dropped_total;
+}
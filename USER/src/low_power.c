@@ -0,0 +1,147 @@
+#include "low_power.h"
+#include "config.h"            // For LOWPOWER_* timing definitions
+#include "scheduler.h"         // Sleep only while no task is due
+#include "uart_driver.h"       // Debug output must be flushed before the clocks stop
+#include "spi_oled_driver.h"   // So must queued display transfers
+#include "cw32f003_awt.h"
+#include "cw32f003_pwr.h"
+#include "cw32f003_rcc.h"
+#include "cw32f003_systick.h"  // For GetTick() and uwTick
+#include <stddef.h>            // For NULL
+
+// AWT clock: LSI / 32, about 1 count per millisecond
+#define LOWPOWER_AWT_TICK_HZ  (LOWPOWER_LSI_HZ / 32)
+#define LOWPOWER_AWT_PERIOD   ((uint32_t)LOWPOWER_IDLE_WAKE_MS * LOWPOWER_AWT_TICK_HZ / 1000)
+
+// --- Private Variables ---
+static uint32_t lowpower_wake_ms = 0;    // GetTick() time of the last deep sleep wake-up
+static LowPower_Stats_t lowpower_stats;
+
+// --- Private Helpers ---
+
+/**
+ * @brief Selects sleep or deep sleep for the next WFI.
+ */
+static void LowPower_SetDeep(bool deep)
+{
+    PWR_InitTypeDef PWR_InitStruct;
+
+    PWR_InitStruct.PWR_Sevonpend = PWR_Sevonpend_Disable;
+    PWR_InitStruct.PWR_SleepDeep = deep ? PWR_SleepDeep_Enable : PWR_SleepDeep_Disable;
+    PWR_InitStruct.PWR_SleepOnExit = PWR_SleepOnExit_Disable;
+    PWR_Config(&PWR_InitStruct);
+}
+
+/**
+ * @brief Deep-sleeps until the AWT (or another enabled interrupt) wakes the core.
+ *        Called with interrupts disabled: the wake-up interrupt is pended, and serviced
+ *        after the tick has been corrected.
+ * @return Time spent asleep (ms).
+ */
+static uint32_t LowPower_DeepSleep(void)
+{
+    uint32_t slept_ms;
+
+    // HCLK stops in deep sleep, and with it SysTick: the AWT keeps time on the LSI
+    SysTick->CTRL &= ~SysTick_CTRL_TICKINT_Msk;
+    AWT_ClearITPendingBit(AWT_IT_UD);
+    NVIC_ClearPendingIRQ(AWT_IRQn);
+    AWT_Cmd(ENABLE);
+
+    LowPower_SetDeep(true);
+    PWR_GotoLpmMode();
+    LowPower_SetDeep(false);
+
+    if (AWT_GetITStatus(AWT_IT_UD) != RESET) {
+        slept_ms = LOWPOWER_IDLE_WAKE_MS;
+    } else {
+        // Woken early: the counter runs up from 0 since AWT_Cmd(ENABLE)
+        slept_ms = (uint32_t)AWT_GetCounter() * 1000 / LOWPOWER_AWT_TICK_HZ;
+        lowpower_stats.early_wakes++;
+    }
+    AWT_Cmd(DISABLE);
+    AWT_ClearITPendingBit(AWT_IT_UD);
+    NVIC_ClearPendingIRQ(AWT_IRQn);
+
+    uwTick += slept_ms; // Tickless: account for the suppressed SysTick interrupts
+    SysTick->CTRL |= SysTick_CTRL_TICKINT_Msk;
+    return slept_ms;
+}
+
+// --- Public Functions ---
+
+/**
+ * @brief Configures the AWT (LSI clocked) as the deep sleep wake-up timer.
+ */
+void LowPower_Init(void)
+{
+#if LOWPOWER_DEEP_SLEEP_ENABLE
+    AWT_TimeCntInitTypeDef AWT_InitStruct;
+
+    RCC_LSI_Enable();        // Already running for the IWDT; waits until stable
+    __RCC_AWT_CLK_ENABLE();
+
+    AWT_InitStruct.AWT_ClkSource = AWT_CLKSOURCE_LSI;
+    AWT_InitStruct.AWT_Prescaler = AWT_PRS_DIV32;
+    AWT_InitStruct.AWT_Period = LOWPOWER_AWT_PERIOD;
+    AWT_InitStruct.AWT_Mode = AWT_MODE_TIMECNT;
+    AWT_TimeCntInit(&AWT_InitStruct);
+    AWT_ITConfig(AWT_IT_UD, ENABLE);
+
+    // Enabled in the NVIC so it can wake the core; serviced only after LowPower_DeepSleep()
+    NVIC_SetPriority(AWT_IRQn, 3);
+    NVIC_EnableIRQ(AWT_IRQn);
+#endif
+    lowpower_wake_ms = GetTick();
+}
+
+/**
+ * @brief Sleeps until the next interrupt if no scheduler task is due.
+ */
+bool LowPower_Idle(bool deep_allowed)
+{
+    bool deep = false;
+
+    __disable_irq(); // Enter critical section: an ISR releasing a task now still wakes the WFI
+
+    if (!Sched_IsDue()) {
+#if LOWPOWER_DEEP_SLEEP_ENABLE
+        if (deep_allowed && (GetTick() - lowpower_wake_ms >= LOWPOWER_AWAKE_MS) && UART_TxIdle() && !OLED_IsBusy()) {
+            uint32_t slept_ms = LowPower_DeepSleep();
+            deep = true;
+            lowpower_stats.deep_sleeps++;
+            lowpower_stats.deep_sleep_ms += slept_ms;
+            if (slept_ms != 0) {
+                lowpower_wake_ms = GetTick(); // Stay awake long enough for fresh CP samples
+                Sched_Realign();
+            }
+        } else
+#endif
+        {
+            (void)deep_allowed;
+            PWR_GotoLpmMode(); // Sleep: peripherals keep running, SysTick wakes within 1 ms
+            lowpower_stats.sleeps++;
+        }
+    }
+
+    __enable_irq();  // Exit critical section: the wake-up interrupt is serviced here
+    return deep;
+}
+
+/**
+ * @brief Gets the sleep residency counters.
+ */
+void LowPower_GetStats(LowPower_Stats_t *stats)
+{
+    if (stats != NULL) {
+        *stats = lowpower_stats; // Only updated from the main loop
+    }
+}
+
+/**
+ * @brief Handles the AWT interrupt. The wake-up itself is accounted in LowPower_DeepSleep().
+ */
+void LowPower_Handle_AWT_IRQ(void)
+{
+    AWT_ClearITPendingBit(AWT_IT_UD);
+}
@@ -3,7 +3,6 @@
 #include "uart_driver.h"
 #include "pwm_driver.h"
 #include "adc_driver.h"   // Include the ADC driver header (used by submodules)
-#include <stdio.h>
 #include "system_cw32f003.h" // Include for SystemCoreClock variable
 #include "cw32f003_iwdt.h"   // Include IWDT header
 #include "cw32f003_systick.h" // Include SysTick header
@@ -11,17 +10,66 @@
 
 // Include new charging gun modules
 #include "charging_sm.h"
+#include "cp_signal.h"      // For CP_StateChangePending()
 #include "ui_display.h"
 #include "ac_measurement.h" // Include AC measurement header
+#include "energy_journal.h" // For Journal_Poll()
+#include "overcurrent.h"    // For OCP_Update()
 #include "spi_oled_driver.h" // Include new SPI OLED driver header
+#include "scheduler.h"
+#include "low_power.h"
+#include "log.h"            // For Log_Drain()
 
 static bool System_Init(void);
 
-// --- Global Task Flags (set by SysTick_Handler) ---
-volatile bool flag_run_state_machine = false; // Set every 10ms
-volatile bool flag_update_display = false;    // Set every 100ms
 extern volatile bool hlw8032_packet_ready;    // Flag defined in ac_measurement.c
-// Add other flags here as needed
+
+// --- Tasks ---
+
+/**
+ * @brief Release condition of the metering task: a complete HLW8032 frame is waiting.
+ */
+static bool Task_Metering_Ready(void)
+{
+    return hlw8032_packet_ready;
+}
+
+/**
+ * @brief Decodes the pending HLW8032 frame and evaluates overcurrent on the fresh sample.
+ */
+static void Task_Metering(void)
+{
+    AC_Process_HLW8032_Packet(); // Clears hlw8032_packet_ready itself
+
+    // A trip opens the contactor right here
+    if (AC_IsDataValid()) {
+        OCP_Update(AC_GetCurrent_mA(), GetTick());
+    }
+}
+
+/**
+ * @brief Refreshes the live readings on the OLED, and redraws at once when requested.
+ *        State changes request a redraw from SM_RunStateMachine() through UI_RequestUpdate().
+ *        Only fields whose text changed are repainted; the SPI interrupt sends them.
+ */
+static void Task_Display(void)
+{
+    UI_RequestUpdate(); // Readings change without a state change
+    if (UI_UpdatePending()) {
+        UI_UpdateDisplay();
+    }
+}
+
+// Task table, in priority order. To add a task, add a row (at most SCHED_MAX_TASKS).
+// Budgets are at 48 MHz; Sched_GetStats() reports measured times against them.
+static const Sched_Task_t app_tasks[] = {
+    // name       run                  ready                   period offset budget_us policy
+    { "sm",       SM_RunStateMachine,  CP_StateChangePending,  10,    0,     500,      SCHED_SKIP },
+    { "metering", Task_Metering,       Task_Metering_Ready,    0,     0,     300,      SCHED_SKIP },
+    { "journal",  Journal_Poll,        Journal_IsBusy,         0,     0,     200,      SCHED_SKIP },
+    { "display",  Task_Display,        UI_UpdatePending,       100,   5,     1000,     SCHED_SKIP },
+    { "log",      Log_Drain,           Log_Pending,            0,     0,     100,      SCHED_SKIP },
+};
 
 
 int32_t main(void)
@@ -32,7 +80,7 @@ int32_t main(void)
         // ErrorHandler_Handle might have already halted if the error was critical.
         // If execution reaches here, it means init failed but wasn't deemed
         // immediately fatal by the handler. We still should not proceed.
-        printf("System Initialization failed. Halting.\r\n");
+        UART_WriteString("System Initialization failed. Halting.\r\n");
         // Optional: Add specific LED blink pattern here for init failure
         while(1) {} // Halt
     }
@@ -51,45 +99,23 @@ int32_t main(void)
 
     UI_UpdateDisplay(); // Display initial state
 
-    while(1) {
-    
-        // --- Time-Sliced Tasks ---
-
-        // Run State Machine (every 10ms approx)
-        if (flag_run_state_machine) {
-            flag_run_state_machine = false; // Clear flag
-            SM_RunStateMachine();
-        }
-
-        // Update Display (every 100ms approx)
-        if (flag_update_display) {
-            flag_update_display = false; // Clear flag
-            // Decide if UI_UpdateDisplay() should be called here periodically,
-            // or only when state actually changes (as currently done in SM_RunStateMachine).
-            // For now, let's keep the update within SM_RunStateMachine on state change,
-            // but this flag could be used for other periodic UI updates (e.g., blinking icons).
-            // UI_UpdateDisplay(); // Example: Call here for periodic updates
-        }
-
-        // Process HLW8032 Packet when ready
-        if (hlw8032_packet_ready) {
-            // Flag is cleared within AC_Process_HLW8032_Packet after processing
-             AC_Process_HLW8032_Packet();
-             // Note: AC_Process_HLW8032_Packet clears the flag itself
-        }
-
-        // Add checks for other flags here...
+    Sched_Init(app_tasks, sizeof(app_tasks) / sizeof(app_tasks[0]));
+    LowPower_Init();
 
+    while(1) {
 
-        // --- Background Tasks ---
+        // Run at most one due task (highest priority first), then come back here
+        bool ran = Sched_Dispatch();
 
         // Refresh the watchdog periodically
-        // Consider moving this into a timed task if precise timing is needed,
-        // but refreshing it frequently in the main loop is usually safe.
+        // Refreshing it on every pass is usually safe; every task runs to completion.
         IWDT_Refresh();
 
-        // Optional: Enter low-power sleep mode if no flags are pending
-        // __WFI(); // Example: Wait For Interrupt instruction
+        // Nothing due: sleep until the next interrupt. With no vehicle connected the
+        // peripheral clocks may stop too (deep sleep, AWT wake-up every LOWPOWER_IDLE_WAKE_MS).
+        if (!ran && LowPower_Idle(SM_GetCurrentState() == SM_STATE_IDLE)) {
+            AC_Measurement_Resync(); // The HLW8032 frame in flight was cut short
+        }
 
     }
 }
@@ -131,6 +157,9 @@ static bool System_Init(void)
     if (!ADC_Driver_Init()) {
         ErrorHandler_Handle(ERROR_ADC_INIT_FAILED, "System_Init", __LINE__);
         overall_status = false;
+    } else if (!ADC_Scan_Start()) { // CP/PP/temperature/VDD sampled in the background from now on
+        ErrorHandler_Handle(ERROR_ADC_INIT_FAILED, "System_Init", __LINE__);
+        overall_status = false;
     }
 
     /* Initialize IWDT (Independent Watchdog Timer) */
@@ -165,11 +194,11 @@ static bool System_Init(void)
 
     // Report overall success/failure
     if (overall_status) {
-        printf("\r\nCW32F003 Core System Initialized Successfully\r\n");
-        printf("IWDT Configured (Timeout ~500ms)\r\n");
-        printf("SysTick Initialized (1ms tick)\r\n");
+        UART_WriteString("\r\nCW32F003 Core System Initialized Successfully\r\n");
+        UART_WriteString("IWDT Configured (Timeout ~500ms)\r\n");
+        UART_WriteString("SysTick Initialized (1ms tick)\r\n");
     } else {
-        printf("\r\nCW32F003 Core System Initialization encountered errors!\r\n");
+        UART_WriteString("\r\nCW32F003 Core System Initialization encountered errors!\r\n");
         // ErrorHandler_Handle was already called for specific errors.
     }
 
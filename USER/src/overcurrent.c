@@ -0,0 +1,186 @@
+#include "overcurrent.h"
+#include "contactor_control.h" // Trip opens the contactor directly
+#include "config.h"            // For HLW_LINK_TIMEOUT_MS
+#include "error_handler.h"     // Include the error handler
+#include "log.h"               // Tokenized logging
+
+// --- Defines ---
+#define OCP_MAX_LIMIT_A     80 // Highest current CP can advertise; keeps the I2t math in 32 bits
+                               // (below the 132 A hard trip: (1320^2 - 880^2) * 250 ms < 2^31)
+#define OCP_MAX_STEP_MS     HLW_LINK_TIMEOUT_MS // Longer gaps are handled by the link watchdog
+
+// --- Private Variables ---
+// Currents in 0.1 A (dA) so that squares stay well inside 32 bits
+static bool ocp_armed = false;
+static OCP_Trip_t ocp_trip = OCP_TRIP_NONE;
+static uint16_t ocp_tol_da = 0;          // Tolerance current (limit + IEC 61851 margin)
+static uint16_t ocp_hard_da = 0;         // Instantaneous trip current
+static uint32_t ocp_tol_sq = 0;          // ocp_tol_da^2
+static uint32_t ocp_i2t_budget = 0;      // dA^2 * ms
+static uint32_t ocp_i2t_acc = 0;         // dA^2 * ms above the tolerance
+static bool ocp_grace_pending = false;   // Start a grace period at the next sample
+static bool ocp_grace = false;           // Grace period running
+static uint32_t ocp_grace_start_ms = 0;
+static bool ocp_have_last = false;       // ocp_last_ms is valid
+static uint32_t ocp_last_ms = 0;
+static bool ocp_overshoot = false;       // Above tolerance since ocp_overshoot_start_ms
+static uint32_t ocp_overshoot_start_ms = 0;
+
+// --- Private Helpers ---
+
+/**
+ * @brief Derives the tolerance, hard trip and I2t budget from the advertised limit.
+ * @param limit_amps Current advertised on CP (A).
+ */
+static void OCP_ApplyLimit(uint8_t limit_amps)
+{
+    uint32_t limit_da;
+
+    if (limit_amps > OCP_MAX_LIMIT_A) {
+        limit_amps = OCP_MAX_LIMIT_A;
+    }
+    limit_da = (uint32_t)limit_amps * 10;
+
+    if (limit_amps <= OCP_TOLERANCE_SPLIT_A) {
+        ocp_tol_da = (uint16_t)(limit_da + OCP_TOLERANCE_ADD_DA);
+    } else {
+        ocp_tol_da = (uint16_t)(limit_da * OCP_TOLERANCE_PERCENT / 100);
+    }
+    // Relative to the tolerance, not the limit: at 6 A, 150 % of the limit (9 A) would sit
+    // only 1 A above the 8 A tolerance and trip transient overshoot without any grace
+    ocp_hard_da = (uint16_t)((uint32_t)ocp_tol_da * OCP_HARD_TRIP_PERCENT / 100);
+
+    // Budget = excess at the reference point, (ref^2 - 1) * Itol^2, held for OCP_I2T_TRIP_MS_AT_REF
+    ocp_tol_sq = (uint32_t)ocp_tol_da * ocp_tol_da;
+    ocp_i2t_budget = (ocp_tol_sq / 100) *
+                     ((uint32_t)OCP_I2T_REF_PERCENT * OCP_I2T_REF_PERCENT - 100 * 100) / 100 *
+                     OCP_I2T_TRIP_MS_AT_REF;
+}
+
+/**
+ * @brief Latches a trip: opens the contactor and reports the error.
+ * @param reason Trip reason.
+ */
+static void OCP_Trip(OCP_Trip_t reason)
+{
+    Contactor_Open(); // Do not wait for the next state machine tick
+    ocp_trip = reason;
+    ocp_armed = false;
+    ErrorHandler_Handle(ERROR_OVERCURRENT, "OCP_Update", __LINE__);
+    LOG2(OCP_TRIP, reason, ocp_tol_da);
+}
+
+// --- Public Functions ---
+
+/**
+ * @brief Arms the protection for a charging session.
+ */
+void OCP_Arm(uint8_t limit_amps)
+{
+    OCP_ApplyLimit(limit_amps);
+    ocp_trip = OCP_TRIP_NONE;
+    ocp_i2t_acc = 0;
+    ocp_have_last = false;
+    ocp_overshoot = false;
+    ocp_grace = false;
+    ocp_grace_pending = true; // Started by the first sample
+    ocp_armed = true;
+}
+
+/**
+ * @brief Changes the advertised limit while armed.
+ */
+void OCP_SetLimit(uint8_t limit_amps)
+{
+    uint16_t old_tol_da = ocp_tol_da;
+
+    OCP_ApplyLimit(limit_amps);
+    if (ocp_armed && ocp_tol_da < old_tol_da) {
+        ocp_grace_pending = true; // The EV gets time to follow the lower limit
+        ocp_overshoot = false;
+    }
+}
+
+/**
+ * @brief Disarms the protection.
+ */
+void OCP_Disarm(void)
+{
+    ocp_armed = false;
+}
+
+/**
+ * @brief Evaluates a new current sample.
+ */
+OCP_Trip_t OCP_Update(uint32_t current_ma, uint32_t now_ms)
+{
+    uint32_t i_da;
+    uint32_t i_sq;
+    uint32_t dt_ms;
+
+    if (!ocp_armed) {
+        return ocp_trip;
+    }
+
+    // Instantaneous trip: checked before any grace period
+    i_da = current_ma / 100;
+    if (i_da >= ocp_hard_da) {
+        OCP_Trip(OCP_TRIP_HARD);
+        return ocp_trip;
+    }
+
+    if (ocp_grace_pending) {
+        ocp_grace_pending = false;
+        ocp_grace = true;
+        ocp_grace_start_ms = now_ms;
+    }
+    dt_ms = ocp_have_last ? (now_ms - ocp_last_ms) : 0;
+    if (dt_ms > OCP_MAX_STEP_MS) {
+        dt_ms = OCP_MAX_STEP_MS;
+    }
+    ocp_last_ms = now_ms;
+    ocp_have_last = true;
+
+    if (ocp_grace) {
+        if (now_ms - ocp_grace_start_ms < OCP_GRACE_MS) {
+            return OCP_TRIP_NONE;
+        }
+        ocp_grace = false;
+    }
+
+    // I2t: integrate the excess over the tolerance, cool down symmetrically below it
+    i_sq = i_da * i_da; // i_da < ocp_hard_da, so this and the products below fit in 32 bits
+    if (i_sq > ocp_tol_sq) {
+        ocp_i2t_acc += (i_sq - ocp_tol_sq) * dt_ms;
+        if (ocp_i2t_acc >= ocp_i2t_budget) {
+            OCP_Trip(OCP_TRIP_I2T);
+            return ocp_trip;
+        }
+    } else {
+        uint32_t cool = (ocp_tol_sq - i_sq) * dt_ms;
+        ocp_i2t_acc = (ocp_i2t_acc > cool) ? (ocp_i2t_acc - cool) : 0;
+    }
+
+    // Deadline: marginal overshoot that I2t alone would tolerate for too long
+    if (i_da > ocp_tol_da) {
+        if (!ocp_overshoot) {
+            ocp_overshoot = true;
+            ocp_overshoot_start_ms = now_ms;
+        } else if (now_ms - ocp_overshoot_start_ms >= OCP_OVERSHOOT_DEADLINE_MS) {
+            OCP_Trip(OCP_TRIP_DEADLINE);
+            return ocp_trip;
+        }
+    } else {
+        ocp_overshoot = false;
+    }
+
+    return OCP_TRIP_NONE;
+}
+
+/**
+ * @brief Gets the reason of the last trip since OCP_Arm().
+ */
+OCP_Trip_t OCP_GetTrip(void)
+{
+    return ocp_trip;
+}
@@ -6,8 +6,32 @@
 #include "cw32f003_gpio.h"
 #include "error_handler.h" // Include the error handler
 
-// Number of ADC samples to average for PP capacity reading
-#define PP_ADC_AVG_SAMPLES 8
+// Samples (2^N) averaged by one hardware burst for PP capacity reading (blocking fallback only)
+#define PP_ADC_AVG_LOG2 3
+
+// PP filter pipeline (fed from the ADC interrupt on every scan)
+#define PP_FILTER_MEDIAN_LEN    5    // PP is static while plugged; reject contact bounce
+#define PP_FILTER_IIR_SHIFT     3    // y += (x - y) / 8
+#define PP_FILTER_HYSTERESIS    40
+
+// Ascending level boundaries (raw, ratiometric); see PP_GetCableCapacity for the ranges.
+// Level N maps to pp_level_capacity[N]; the gaps between cable ranges stay invalid.
+static const uint16_t pp_level_thresholds[] = {
+    200,  // 63A:  200 - 499
+    500,  // 32A:  500 - 1000
+    1001, // invalid gap
+    1400, // 20A: 1400 - 1900
+    1901, // invalid gap
+    2200, // 13A: 2200 - 2700
+    2701  // open circuit / invalid
+};
+static const uint16_t pp_level_capacity[] = {
+    PP_CAPACITY_UNKNOWN, PP_CAPACITY_63A, PP_CAPACITY_32A, PP_CAPACITY_UNKNOWN,
+    PP_CAPACITY_20A, PP_CAPACITY_UNKNOWN, PP_CAPACITY_13A, PP_CAPACITY_UNKNOWN
+};
+#define PP_LEVEL_COUNT (sizeof(pp_level_thresholds) / sizeof(pp_level_thresholds[0]))
+
+static ADC_Filter_t pp_filter;
 
 // --- Initialization ---
 
@@ -25,6 +49,11 @@ void PP_Signal_Init(void)
     GPIO_InitStruct.Mode = GPIO_MODE_ANALOG; // Analog mode for ADC
     GPIO_Init(PP_ADC_GPIO_PORT, &GPIO_InitStruct);
 
+    // Median + IIR + hysteresis on every PP sample, run by the ADC interrupt
+    ADC_Filter_Init(&pp_filter, PP_FILTER_MEDIAN_LEN, PP_FILTER_IIR_SHIFT,
+                    pp_level_thresholds, PP_LEVEL_COUNT, PP_FILTER_HYSTERESIS);
+    ADC_Scan_AttachFilter(ADC_SCAN_SLOT_PP, &pp_filter, false);
+
     // Ensure the specific channel (PP_ADC_CHANNEL) is configured if needed by ADC_Driver_Init
     // ADC_Driver_Init(); // Might not be needed if called globally
 }
@@ -49,6 +78,7 @@ uint16_t PP_GetCableCapacity(void)
     // R_pp = R_pullup * ADC_Voltage / (3.3V - ADC_Voltage)
     // R_pp = 1000 * (RawValue * 3300 / 4095) / (3300 - (RawValue * 3300 / 4095))
     // R_pp = 1000 * RawValue / (4095 - RawValue)
+    // Pull-up and ADC reference are both VDD, so the raw value is ratiometric: no VDD compensation
 
     // Define thresholds based on RAW ADC values (approximate, needs calibration)
     // R_pp = 1500 (13A) => Raw = 4095 * 1500 / (1000 + 1500) = 2457. Range: 2200 - 2700
@@ -58,48 +88,35 @@ uint16_t PP_GetCableCapacity(void)
     // Open circuit (No cable): R_pp = infinity => Raw = 4095. Treat as Unknown/Error?
     // Short circuit (Error): R_pp = 0 => Raw = 0. Treat as Unknown/Error.
 
-    const uint16_t THRESHOLD_13A_LOW = 2200;
-    const uint16_t THRESHOLD_13A_HIGH = 2700;
-    const uint16_t THRESHOLD_20A_LOW = 1400;
-    const uint16_t THRESHOLD_20A_HIGH = 1900;
-    const uint16_t THRESHOLD_32A_LOW = 500;
-    const uint16_t THRESHOLD_32A_HIGH = 1000;
-    const uint16_t THRESHOLD_63A_LOW = 200;
-    const uint16_t THRESHOLD_63A_HIGH = 500;
-    const uint16_t ADC_ERROR_VALUE = 0xFFFF; // Value returned by ADC_Read_Channel_Raw on timeout
-
-    uint32_t adc_sum = 0;
-    uint16_t adc_raw_single = 0;
-    uint16_t adc_raw_avg = 0;
-    int i;
+    // The ranges are encoded as level boundaries in pp_level_thresholds
+    const uint16_t ADC_ERROR_VALUE = 0xFFFF; // Value returned by ADC_Read_Channel_Raw on timeout / empty scan slot
 
-    // Read multiple samples and average
-    for (i = 0; i < PP_ADC_AVG_SAMPLES; i++) {
-        adc_raw_single = ADC_Read_Channel_Raw(PP_ADC_CHANNEL); // Read PP channel
+    uint16_t adc_raw_avg = 0;
+    uint8_t level;
+    uint16_t capacity;
 
-        // Check for ADC read error (timeout) on any sample
-        if (adc_raw_single == ADC_ERROR_VALUE) {
-            // Error already reported by ADC_Read_Channel_Raw via ErrorHandler_Handle
+    if (ADC_Scan_IsRunning()) {
+        // Samples are median/IIR filtered and classified with hysteresis in the ADC interrupt
+        if (!ADC_Filter_IsPrimed(&pp_filter)) {
+            return PP_CAPACITY_UNKNOWN; // Not converted yet
+        }
+        level = ADC_Filter_GetLevel(&pp_filter);
+    } else {
+        // One counted hardware burst (single configuration, EOA interrupt) instead of 8 polled reads
+        adc_raw_avg = ADC_Read_Channel_Average(PP_ADC_CHANNEL, PP_ADC_AVG_LOG2);
+        if (adc_raw_avg == ADC_ERROR_VALUE) {
+            // Error already reported by the ADC driver via ErrorHandler_Handle
             return PP_CAPACITY_UNKNOWN; // Return unknown capacity immediately
         }
-        adc_sum += adc_raw_single;
+        level = ADC_Filter_LevelOf(pp_level_thresholds, PP_LEVEL_COUNT, adc_raw_avg);
     }
-    adc_raw_avg = (uint16_t)(adc_sum / PP_ADC_AVG_SAMPLES);
-
-
-    // Determine capacity based on the *average* thresholds
-    if (adc_raw_avg >= THRESHOLD_13A_LOW && adc_raw_avg <= THRESHOLD_13A_HIGH) {
-        return PP_CAPACITY_13A;
-    } else if (adc_raw_avg >= THRESHOLD_20A_LOW && adc_raw_avg <= THRESHOLD_20A_HIGH) {
-        return PP_CAPACITY_20A;
-    } else if (adc_raw_avg >= THRESHOLD_32A_LOW && adc_raw_avg <= THRESHOLD_32A_HIGH) {
-        return PP_CAPACITY_32A;
-    } else if (adc_raw_avg >= THRESHOLD_63A_LOW && adc_raw_avg <= THRESHOLD_63A_HIGH) {
-        return PP_CAPACITY_63A;
-    } else {
+
+    // Determine capacity from the level (count of boundaries below the reading)
+    capacity = pp_level_capacity[level];
+    if (capacity == PP_CAPACITY_UNKNOWN) {
         // Outside known ranges, or very low/high values indicating open/short
         // Report this potentially invalid resistance reading
         ErrorHandler_Handle(ERROR_PP_RESISTANCE_INVALID, "PP_GetCapacity", __LINE__);
-        return PP_CAPACITY_UNKNOWN;
     }
+    return capacity;
 }
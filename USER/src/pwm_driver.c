@@ -8,6 +8,39 @@
 // Store configuration for getter functions
 static uint32_t pwm_frequency = 0;
 static uint8_t pwm_duty_cycle = 0;
+static bool pwm_adc_sync_enabled = false;
+
+/**
+ * @brief Places the ADC trigger compares in the middle of the high and the low plateau.
+ *        A plateau that does not exist at the current duty (0% / 100%) gets no trigger;
+ *        its compare flag still fires, and the ADC ISR ignores it.
+ * @param arrValue Current auto-reload value (period - 1).
+ * @param ccrValue Current CH2B compare value (high time in timer counts).
+ */
+static void PWM_UpdateAdcSyncPoints(uint32_t arrValue, uint32_t ccrValue)
+{
+    uint32_t period = arrValue + 1;
+
+    if (!pwm_adc_sync_enabled) {
+        return;
+    }
+
+    // High plateau: [0, CCR) in PWM1 up-counting mode
+    if (ccrValue > 0) {
+        ATIM_SetCompare1A((uint16_t)(ccrValue / 2));
+        ATIM_ADCTriggerConfig(CP_SYNC_HIGH_TRIGGER, ENABLE);
+    } else {
+        ATIM_ADCTriggerConfig(CP_SYNC_HIGH_TRIGGER, DISABLE);
+    }
+
+    // Low plateau: [CCR, ARR]
+    if (ccrValue < period) {
+        ATIM_SetCompare3A((uint16_t)(ccrValue + (period - ccrValue) / 2));
+        ATIM_ADCTriggerConfig(CP_SYNC_LOW_TRIGGER, ENABLE);
+    } else {
+        ATIM_ADCTriggerConfig(CP_SYNC_LOW_TRIGGER, DISABLE);
+    }
+}
 
 
 /**
@@ -213,12 +246,59 @@ bool PWM_Set_DutyCycle(uint8_t dutyCyclePercent)
     // Assuming ATIM is the timer used
     ATIM_SetCompare2B(ccrValue);
 
+    // Move the ADC sampling points along with the new edge
+    PWM_UpdateAdcSyncPoints(arrValue, ccrValue);
+
     // Update stored duty cycle
     pwm_duty_cycle = dutyCyclePercent;
 
     return true;
 }
 
+/**
+ * @brief Returns the CP output to PWM mode after PWM_FORCE_OUTPUT_LOW(), at the duty
+ *        cycle last set with PWM_Set_DutyCycle().
+ */
+void PWM_ReleaseOutput(void)
+{
+    __disable_irq(); // Enter critical section (FLTR is also written by the fast-trip ISR)
+    REGBITS_MODIFY(CW_ATIM->FLTR, ATIM_FLTR_OCM2BFLT2B_Msk, ATIM_OCMODE_PWM1 << ATIM_FLTR_OCM2BFLT2B_Pos);
+    __enable_irq();  // Exit critical section
+}
+
+/**
+ * @brief Enables or disables ADC triggering synchronised to the PWM plateaus.
+ *        Uses the spare ATIM compare channels CH1A/CH3A (compare events only, no pin output).
+ * @param enable true to place triggers in the high and low plateau, false to remove them.
+ * @return true if successful.
+ */
+bool PWM_EnableAdcSync(bool enable)
+{
+    ATIM_OCInitTypeDef ATIM_OCInitStruct;
+    uint32_t arrValue;
+
+    if (!enable) {
+        ATIM_ADCTriggerConfig(CP_SYNC_HIGH_TRIGGER | CP_SYNC_LOW_TRIGGER, DISABLE);
+        pwm_adc_sync_enabled = false;
+        return true;
+    }
+
+    // Compare-only channels: buffered so moved points take effect at the next period
+    ATIM_OCInitStruct.BufferState = ENABLE;
+    ATIM_OCInitStruct.OCInterruptSelect = ATIM_OC_IT_UP_COUNTER; // Match flag on up-count (interrupt stays off)
+    ATIM_OCInitStruct.OCInterruptState = DISABLE;
+    ATIM_OCInitStruct.OCMode = ATIM_OCMODE_FORCED_INACTIVE;
+    ATIM_OCInitStruct.OCPolarity = ATIM_OCPOLARITY_NONINVERT;
+    ATIM_OC1AInit(&ATIM_OCInitStruct);
+    ATIM_OC3AInit(&ATIM_OCInitStruct);
+
+    pwm_adc_sync_enabled = true;
+
+    arrValue = CW_ATIM->ARR;
+    PWM_UpdateAdcSyncPoints(arrValue, ((arrValue + 1) * pwm_duty_cycle) / 100);
+    return true;
+}
+
 /**
  * @brief Sets the PWM frequency.
  * @param freqHz New frequency in Hz.
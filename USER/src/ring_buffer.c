@@ -0,0 +1,107 @@
+#include "ring_buffer.h"
+#include <stddef.h> // For NULL
+
+// Storage and index accesses are all volatile, so the compiler keeps the data write
+// ahead of the index update that publishes it. The Cortex-M0+ is single-core and
+// in-order, so no hardware barrier is needed.
+
+/**
+ * @brief Initializes an empty ring on caller-provided storage.
+ */
+bool RingBuffer_Init(RingBuffer_t *rb, volatile uint8_t *storage, uint16_t size)
+{
+    if (rb == NULL || storage == NULL || size < 2 || size > 32768 || (size & (size - 1)) != 0) {
+        return false;
+    }
+    rb->buffer = storage;
+    rb->mask = (uint16_t)(size - 1);
+    rb->head = 0;
+    rb->tail = 0;
+    return true;
+}
+
+/**
+ * @brief Adds one byte (producer side).
+ */
+bool RingBuffer_Put(RingBuffer_t *rb, uint8_t data)
+{
+    uint16_t head = rb->head;
+
+    if ((uint16_t)(head - rb->tail) > rb->mask) {
+        return false; // Full
+    }
+    rb->buffer[head & rb->mask] = data;
+    rb->head = (uint16_t)(head + 1); // Publish
+    return true;
+}
+
+/**
+ * @brief Removes one byte (consumer side).
+ */
+bool RingBuffer_Get(RingBuffer_t *rb, uint8_t *data)
+{
+    uint16_t tail = rb->tail;
+
+    if (tail == rb->head) {
+        return false; // Empty
+    }
+    *data = rb->buffer[tail & rb->mask];
+    rb->tail = (uint16_t)(tail + 1); // Release the slot
+    return true;
+}
+
+/**
+ * @brief Adds up to length bytes (producer side).
+ */
+uint16_t RingBuffer_PutBulk(RingBuffer_t *rb, const uint8_t *data, uint16_t length)
+{
+    uint16_t head = rb->head;
+    uint16_t space = (uint16_t)(rb->mask + 1 - (uint16_t)(head - rb->tail));
+    uint16_t n = (length < space) ? length : space;
+
+    for (uint16_t i = 0; i < n; i++) {
+        rb->buffer[(head + i) & rb->mask] = data[i];
+    }
+    rb->head = (uint16_t)(head + n); // Publish all at once
+    return n;
+}
+
+/**
+ * @brief Removes up to length bytes (consumer side).
+ */
+uint16_t RingBuffer_GetBulk(RingBuffer_t *rb, uint8_t *data, uint16_t length)
+{
+    uint16_t tail = rb->tail;
+    uint16_t count = (uint16_t)(rb->head - tail);
+    uint16_t n = (length < count) ? length : count;
+
+    for (uint16_t i = 0; i < n; i++) {
+        data[i] = rb->buffer[(tail + i) & rb->mask];
+    }
+    rb->tail = (uint16_t)(tail + n); // Release all at once
+    return n;
+}
+
+/**
+ * @brief Gets the number of bytes queued.
+ */
+uint16_t RingBuffer_Count(const RingBuffer_t *rb)
+{
+    return (uint16_t)(rb->head - rb->tail);
+}
+
+/**
+ * @brief Checks whether the ring holds no data.
+ */
+bool RingBuffer_IsEmpty(const RingBuffer_t *rb)
+{
+    return rb->head == rb->tail;
+}
+
+/**
+ * @brief Checks whether the ring has no free slot.
+ */
+bool RingBuffer_IsFull(const RingBuffer_t *rb)
+{
+    return (uint16_t)(rb->head - rb->tail) > rb->mask;
+}
@@ -0,0 +1,182 @@
+#include "scheduler.h"
+#include "cw32f003_systick.h" // For GetTick() and uwTick
+#include "system_cw32f003.h"  // For SystemCoreClock
+#include "error_handler.h"    // Include the error handler
+#include <stddef.h>           // For NULL
+#include <string.h>           // For memset
+
+// --- Private Variables ---
+static const Sched_Task_t *sched_tasks = NULL;
+static uint8_t sched_count = 0;
+static uint32_t sched_next_ms[SCHED_MAX_TASKS];   // Next periodic release (GetTick() time)
+static Sched_Stats_t sched_stats[SCHED_MAX_TASKS];
+static uint32_t sched_cycles_per_us = 48;
+
+// --- Private Helpers ---
+
+/**
+ * @brief Takes a consistent (tick, SysTick VAL) time stamp.
+ *        VAL counts down from LOAD once per millisecond; a reload between the two reads is
+ *        detected by the tick changing and the sample is retaken.
+ * @param tick Filled with the millisecond tick.
+ * @return SysTick VAL at that tick.
+ */
+static uint32_t Sched_Timestamp(uint32_t *tick)
+{
+    uint32_t t;
+    uint32_t val;
+
+    do {
+        t = uwTick;
+        val = SysTick->VAL;
+    } while (t != uwTick);
+
+    *tick = t;
+    return val;
+}
+
+/**
+ * @brief Converts two time stamps into elapsed microseconds (saturating at 65535).
+ */
+static uint16_t Sched_ElapsedUs(uint32_t tick0, uint32_t val0, uint32_t tick1, uint32_t val1)
+{
+    uint32_t reload = SysTick->LOAD + 1;
+    uint32_t ms = tick1 - tick0;
+    uint32_t cycles;
+
+    if (ms >= 65) {
+        return UINT16_MAX; // Beyond the 16-bit range anyway
+    }
+    cycles = ms * reload + val0 - val1; // VAL counts down
+    cycles /= sched_cycles_per_us;
+    return (cycles > UINT16_MAX) ? UINT16_MAX : (uint16_t)cycles;
+}
+
+// --- Public Functions ---
+
+/**
+ * @brief Installs the task table and schedules the first releases.
+ */
+bool Sched_Init(const Sched_Task_t *tasks, uint8_t count)
+{
+    uint32_t now = GetTick();
+
+    if (tasks == NULL || count == 0 || count > SCHED_MAX_TASKS) {
+        ErrorHandler_Handle(ERROR_INVALID_PARAM, "Sched_Init", __LINE__);
+        return false;
+    }
+
+    sched_tasks = tasks;
+    sched_count = count;
+    sched_cycles_per_us = SystemCoreClock / 1000000;
+    if (sched_cycles_per_us == 0) {
+        sched_cycles_per_us = 1;
+    }
+    for (uint8_t i = 0; i < count; i++) {
+        sched_next_ms[i] = now + tasks[i].offset_ms;
+    }
+    Sched_ResetStats();
+    return true;
+}
+
+/**
+ * @brief Runs the highest-priority due task, if any.
+ */
+bool Sched_Dispatch(void)
+{
+    uint32_t now = GetTick();
+
+    for (uint8_t i = 0; i < sched_count; i++) {
+        const Sched_Task_t *task = &sched_tasks[i];
+        bool periodic_due = (task->period_ms != 0) && ((int32_t)(now - sched_next_ms[i]) >= 0);
+        bool event_due = (task->ready != NULL) && task->ready();
+
+        if (!periodic_due && !event_due) {
+            continue;
+        }
+
+        if (periodic_due) {
+            // Late by a full period or more: the previous deadline was missed
+            uint32_t late = now - sched_next_ms[i];
+            if (late >= task->period_ms) {
+                sched_stats[i].misses++;
+            }
+            if (task->policy == SCHED_SKIP && late >= task->period_ms) {
+                sched_next_ms[i] += (late / task->period_ms) * task->period_ms;
+            }
+            sched_next_ms[i] += task->period_ms;
+        } else if (task->period_ms != 0) {
+            sched_next_ms[i] = now + task->period_ms; // An event run also serves this period
+        }
+
+        uint32_t tick0, tick1;
+        uint32_t val0 = Sched_Timestamp(&tick0);
+        task->run();
+        uint32_t val1 = Sched_Timestamp(&tick1);
+
+        Sched_Stats_t *st = &sched_stats[i];
+        st->last_us = Sched_ElapsedUs(tick0, val0, tick1, val1);
+        if (st->last_us > st->wcet_us) {
+            st->wcet_us = st->last_us;
+        }
+        if (st->last_us > task->budget_us) {
+            st->overruns++;
+        }
+        st->runs++;
+        return true; // Run to completion, then rescan from the highest priority
+    }
+    return false;
+}
+
+/**
+ * @brief Checks whether any task is due, without running it.
+ */
+bool Sched_IsDue(void)
+{
+    uint32_t now = GetTick();
+
+    for (uint8_t i = 0; i < sched_count; i++) {
+        const Sched_Task_t *task = &sched_tasks[i];
+        if ((task->period_ms != 0) && ((int32_t)(now - sched_next_ms[i]) >= 0)) {
+            return true;
+        }
+        if ((task->ready != NULL) && task->ready()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Realigns periodic releases that fell behind while the tick was suspended.
+ */
+void Sched_Realign(void)
+{
+    uint32_t now = GetTick();
+
+    for (uint8_t i = 0; i < sched_count; i++) {
+        if ((sched_tasks[i].period_ms != 0) && ((int32_t)(now - sched_next_ms[i]) > 0)) {
+            sched_next_ms[i] = now; // Due once now, not once per slept period
+        }
+    }
+}
+
+/**
+ * @brief Gets the statistics of one task.
+ */
+bool Sched_GetStats(uint8_t index, Sched_Stats_t *stats)
+{
+    if (index >= sched_count || stats == NULL) {
+        return false;
+    }
+    *stats = sched_stats[index];
+    return true;
+}
+
+/**
+ * @brief Clears all statistics.
+ */
+void Sched_ResetStats(void)
+{
+    memset(sched_stats, 0, sizeof(sched_stats));
+}
@@ -16,6 +16,24 @@
 // Define a reasonable timeout for SPI flag waits
 // Adjust based on SPI clock speed and expected transaction time
 #define SPI_TIMEOUT_COUNT 10000
+// Blocking writes wait this long for the transfer queue to drain (a full queue is ~6 ms)
+#define OLED_TXQ_TIMEOUT_COUNT 100000
+
+// --- Asynchronous transfer queue (producer: main loop, consumer: SPI TXE ISR) ---
+typedef struct {
+    const uint8_t *data;            // Data bytes (DC high), referenced, not copied
+    uint8_t cmd[OLED_SEG_CMD_MAX];  // Command bytes (DC low), sent first
+    uint8_t cmd_len;
+    uint8_t data_len;
+} OLED_Segment_t;
+
+static volatile OLED_Segment_t oled_txq[OLED_TXQ_SIZE];
+static volatile uint8_t oled_txq_head = 0; // Free-running; written by the producer only
+static volatile uint8_t oled_txq_tail = 0; // Free-running; written by the ISR only
+static uint8_t oled_tx_pos = 0;            // Next byte of the segment at the tail (ISR only)
+static bool oled_tx_dc_data = false;       // DC level driven by the ISR
+static volatile bool oled_tx_active = false; // CS held and TXE interrupt enabled
+static volatile OLED_TxDoneCallback_t oled_tx_done_cb = NULL;
 
 /**
  * @brief Sends a single byte via SPI with timeout.
@@ -51,6 +69,200 @@ static bool SPI_WriteByte(uint8_t data)
     return true;
 }
 
+/**
+ * @brief Sends a run of bytes via SPI with timeout, keeping the TX buffer full.
+ *        Waits for BUSY only once, after the last byte, so the caller may then
+ *        toggle DC or release CS.
+ * @param data Bytes to send.
+ * @param length Number of bytes to send.
+ * @param fill true to send data[0] length times (clear/fill), false to send data[0..length-1].
+ * @return true if successful, false on timeout.
+ */
+static bool SPI_WriteBurst(const uint8_t *data, uint16_t length, bool fill)
+{
+    volatile uint32_t timeout;
+    uint16_t i;
+
+    for (i = 0; i < length; i++)
+    {
+        timeout = SPI_TIMEOUT_COUNT;
+        while (SPI_GetFlagStatus(SPI_FLAG_TXE) == RESET)
+        {
+            if (timeout-- == 0) {
+                ErrorHandler_Handle(ERROR_TIMEOUT, "SPI_Burst_TXE", __LINE__);
+                return false;
+            }
+        }
+        SPI_SendData(fill ? data[0] : data[i]);
+    }
+
+    timeout = SPI_TIMEOUT_COUNT;
+    while (SPI_GetFlagStatus(SPI_FLAG_BUSY) == SET)
+    {
+        if (timeout-- == 0) {
+            ErrorHandler_Handle(ERROR_TIMEOUT, "SPI_Burst_BUSY", __LINE__);
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Waits until the shift register is empty, with timeout.
+ *        Called from the TXE ISR before changing DC or CS: at most one byte time.
+ * @return true if successful, false on timeout.
+ */
+static bool OLED_TxWaitShifted(void)
+{
+    volatile uint32_t timeout = SPI_TIMEOUT_COUNT;
+    while (SPI_GetFlagStatus(SPI_FLAG_BUSY) == SET)
+    {
+        if (timeout-- == 0) {
+            ErrorHandler_Handle(ERROR_TIMEOUT, "OLED_TxISR_BUSY", __LINE__);
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Drives DC for the next byte queued by the ISR. The controller samples DC
+ *        with the last bit of each byte, so the previous byte must be out first.
+ * @param data_mode true for data (DC high), false for command (DC low).
+ */
+static void OLED_TxSetDC(bool data_mode)
+{
+    if (data_mode != oled_tx_dc_data) {
+        OLED_TxWaitShifted();
+        if (data_mode) {
+            OLED_DC_HIGH();
+        } else {
+            OLED_DC_LOW();
+        }
+        oled_tx_dc_data = data_mode;
+    }
+}
+
+/**
+ * @brief Starts the TXE interrupt if the queue is idle.
+ */
+static void OLED_TxStart(void)
+{
+    __disable_irq(); // Enter critical section (shared with the TXE ISR)
+    if (!oled_tx_active) {
+        oled_tx_active = true;
+        oled_tx_pos = 0;
+        OLED_DC_LOW();  // Bus is idle: no need to wait
+        oled_tx_dc_data = false;
+        OLED_CS_LOW();  // Held until the queue drains
+        SPI_ITConfig(SPI_IT_TXE, ENABLE); // TX buffer is empty: the ISR runs at once
+    }
+    __enable_irq();  // Exit critical section
+}
+
+/**
+ * @brief Waits for queued transfers to finish before a blocking write takes the bus.
+ * @return true if the queue is idle, false on timeout.
+ */
+static bool OLED_WaitTxQueue(void)
+{
+    volatile uint32_t timeout = OLED_TXQ_TIMEOUT_COUNT;
+    while (oled_tx_active)
+    {
+        if (timeout-- == 0) {
+            ErrorHandler_Handle(ERROR_TIMEOUT, "OLED_WaitTxQueue", __LINE__);
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Queues one transfer segment and returns immediately.
+ */
+bool OLED_QueueTransfer(const uint8_t *cmd, uint8_t cmd_len, const uint8_t *data, uint8_t data_len)
+{
+    volatile OLED_Segment_t *seg;
+    uint8_t i;
+
+    if (cmd_len > OLED_SEG_CMD_MAX || (cmd_len == 0 && data_len == 0)) {
+        return false; // Invalid segment
+    }
+    if ((uint8_t)(oled_txq_head - oled_txq_tail) >= OLED_TXQ_SIZE) {
+        return false; // Queue full
+    }
+
+    seg = &oled_txq[oled_txq_head & (OLED_TXQ_SIZE - 1)];
+    for (i = 0; i < cmd_len; i++) {
+        seg->cmd[i] = cmd[i];
+    }
+    seg->cmd_len = cmd_len;
+    seg->data = data;
+    seg->data_len = data_len;
+    oled_txq_head++; // Publish: the slot is complete before the ISR can see it
+
+    OLED_TxStart();
+    return true;
+}
+
+/**
+ * @brief Checks whether queued transfers are still in progress.
+ */
+bool OLED_IsBusy(void)
+{
+    return oled_tx_active;
+}
+
+/**
+ * @brief Registers a function called when the transfer queue drains.
+ */
+void OLED_SetTxDoneCallback(OLED_TxDoneCallback_t callback)
+{
+    oled_tx_done_cb = callback; // Single pointer write, atomic on Cortex-M0+
+}
+
+/**
+ * @brief Sends the next queued byte. Called from SPI_IRQHandler on TXE.
+ */
+void OLED_SPI_Handle_TXE(void)
+{
+    OLED_TxDoneCallback_t callback;
+
+    while (oled_txq_tail != oled_txq_head) {
+        volatile OLED_Segment_t *seg = &oled_txq[oled_txq_tail & (OLED_TXQ_SIZE - 1)];
+        uint8_t pos = oled_tx_pos;
+
+        if (pos < seg->cmd_len) {
+            OLED_TxSetDC(false);
+            SPI_SendData(seg->cmd[pos]);
+            oled_tx_pos = pos + 1;
+            return;
+        }
+        pos -= seg->cmd_len;
+        if (pos < seg->data_len) {
+            OLED_TxSetDC(true);
+            SPI_SendData(seg->data[pos]);
+            oled_tx_pos++;
+            return;
+        }
+
+        // Segment done, free its slot
+        oled_tx_pos = 0;
+        oled_txq_tail++;
+    }
+
+    // Queue drained: let the last byte out, then release the bus
+    SPI_ITConfig(SPI_IT_TXE, DISABLE);
+    OLED_TxWaitShifted();
+    OLED_CS_HIGH();
+    oled_tx_active = false;
+
+    callback = oled_tx_done_cb;
+    if (callback != NULL) {
+        callback();
+    }
+}
+
 /**
  * @brief Writes a single command byte to the OLED via SPI.
  * @param command The command byte to write.
@@ -59,6 +271,7 @@ static bool SPI_WriteByte(uint8_t data)
 bool OLED_WriteCommand(uint8_t command)
 {
     bool status;
+    if (!OLED_WaitTxQueue()) return false;
     OLED_DC_LOW();  // Select command mode
     OLED_CS_LOW();  // Select OLED
     status = SPI_WriteByte(command);
@@ -74,6 +287,7 @@ bool OLED_WriteCommand(uint8_t command)
 bool OLED_WriteData(uint8_t data)
 {
     bool status;
+    if (!OLED_WaitTxQueue()) return false;
     OLED_DC_HIGH(); // Select data mode
     OLED_CS_LOW();  // Select OLED
     status = SPI_WriteByte(data);
@@ -81,6 +295,108 @@ bool OLED_WriteData(uint8_t data)
     return status;
 }
 
+/**
+ * @brief Writes a run of bytes to one page in a single CS-held transaction:
+ *        the three cursor commands (DC low), then the data burst (DC high).
+ * @param x Starting column (0-127).
+ * @param page Page (0-7).
+ * @param data Bytes to write.
+ * @param length Number of bytes.
+ * @param fill true to repeat data[0] (see SPI_WriteBurst).
+ * @return true if successful, false on SPI communication failure.
+ */
+static bool OLED_WritePageRun(uint8_t x, uint8_t page, const uint8_t *data, uint8_t length, bool fill)
+{
+    uint8_t cmd[3];
+    bool status;
+
+    cmd[0] = 0xB0 + page;         // Set Page Start Address
+    cmd[1] = 0x00 | (x & 0x0F);   // Set Lower Column Start Address
+    cmd[2] = 0x10 | (x >> 4);     // Set Higher Column Start Address
+
+    if (!OLED_WaitTxQueue()) return false;
+    OLED_CS_LOW();  // Select OLED for the whole run
+    OLED_DC_LOW();  // Command mode
+    status = SPI_WriteBurst(cmd, sizeof(cmd), false);
+    if (status) {
+        OLED_DC_HIGH(); // Data mode (the commands have fully shifted out)
+        status = SPI_WriteBurst(data, length, fill);
+    }
+    OLED_CS_HIGH(); // Deselect OLED
+    return status;
+}
+
+#ifdef OLED_USE_BUFFER
+// Screen buffer, one byte per column per page, same layout as the panel GRAM
+uint8_t OLED_GRAM[OLED_WIDTH * OLED_HEIGHT / 8];
+
+// Per-page dirty column span [lo, hi); hi == 0 means the page matches the panel
+static uint8_t oled_dirty_lo[OLED_PAGES];
+static uint8_t oled_dirty_hi[OLED_PAGES];
+
+/**
+ * @brief Adds columns x0..x1 (inclusive) of a page to its dirty span.
+ */
+static void OLED_MarkDirty(uint8_t page, uint8_t x0, uint8_t x1)
+{
+    if (oled_dirty_hi[page] == 0) {
+        oled_dirty_lo[page] = x0;
+        oled_dirty_hi[page] = x1 + 1;
+    } else {
+        if (x0 < oled_dirty_lo[page]) oled_dirty_lo[page] = x0;
+        if (x1 >= oled_dirty_hi[page]) oled_dirty_hi[page] = x1 + 1;
+    }
+}
+#endif
+
+/**
+ * @brief Draws a run of bytes into one page. With OLED_USE_BUFFER the run is
+ *        diffed into OLED_GRAM and only changed columns are marked for
+ *        OLED_UpdateScreen(); otherwise it is written to the panel directly.
+ *        Columns past the right edge and pages past the bottom are clipped.
+ * @param x Starting column (0-127).
+ * @param page Page (0-7).
+ * @param data Bytes to draw.
+ * @param length Number of bytes.
+ * @param fill true to repeat data[0] (see SPI_WriteBurst).
+ * @return true if successful, false on SPI communication failure.
+ */
+static bool OLED_DrawPageRun(uint8_t x, uint8_t page, const uint8_t *data, uint8_t length, bool fill)
+{
+    if (page >= OLED_PAGES || x >= OLED_WIDTH) {
+        return true; // Nothing visible to draw
+    }
+    if (length > OLED_WIDTH - x) {
+        length = OLED_WIDTH - x;
+    }
+
+#ifdef OLED_USE_BUFFER
+    {
+        uint8_t *gram = &OLED_GRAM[page * OLED_WIDTH + x];
+        uint8_t i, lo = 0, hi = 0;
+        bool changed = false;
+
+        for (i = 0; i < length; i++) {
+            uint8_t b = fill ? data[0] : data[i];
+            if (gram[i] != b) {
+                gram[i] = b;
+                if (!changed) {
+                    lo = i;
+                    changed = true;
+                }
+                hi = i;
+            }
+        }
+        if (changed) {
+            OLED_MarkDirty(page, x + lo, x + hi);
+        }
+        return true;
+    }
+#else
+    return OLED_WritePageRun(x, page, data, length, fill);
+#endif
+}
+
 //--------------------------------------------------------------------------------------------------
 // OLED Initialization
 //--------------------------------------------------------------------------------------------------
@@ -89,6 +405,9 @@ bool OLED_Init(void)
     GPIO_InitTypeDef GPIO_InitStructure;
     SPI_InitTypeDef SPI_InitStruct;
 
+    // Re-initialisation: let queued transfers finish before reconfiguring the bus
+    if (!OLED_WaitTxQueue()) return false;
+
     // 1. Enable Clocks
     RCC_AHBPeriphClk_Enable(RCC_AHB_PERIPH_GPIOB | RCC_AHB_PERIPH_GPIOC, ENABLE); // Use correct constants
     RCC_APBPeriphClk_Enable2(RCC_APB2_PERIPH_SPI, ENABLE); // Use APB2 enable function and constant
@@ -144,7 +463,8 @@ bool OLED_Init(void)
     SPI_InitStruct.SPI_CPOL = SPI_CPOL_Low;    // Clock low when idle (Mode 0 or 3) - Check SSD1309 datasheet
     SPI_InitStruct.SPI_CPHA = SPI_CPHA_1Edge;  // Data captured on first clock edge (Mode 0) - Check SSD1309 datasheet
     SPI_InitStruct.SPI_NSS = SPI_NSS_Soft;     // Use software control for CS pin
-    SPI_InitStruct.SPI_BaudRatePrescaler = SPI_BaudRatePrescaler_8; // SPI Clock = PCLK / 8 (Adjust as needed)
+    // SPI Clock = PCLK / 32 (1.5 MHz): one TXE interrupt every ~5 us leaves the CPU free between bytes
+    SPI_InitStruct.SPI_BaudRatePrescaler = SPI_BaudRatePrescaler_32;
     SPI_InitStruct.SPI_FirstBit = SPI_FirstBit_MSB;
     // SPI_InitStruct.SPI_Speed = SPI_Speed_High; // Add speed setting if needed/available
     SPI_Init(&SPI_InitStruct); // Removed OLED_SPI_PERIPH argument
@@ -152,6 +472,11 @@ bool OLED_Init(void)
     // Enable SPI
     SPI_Cmd(ENABLE); // Removed OLED_SPI_PERIPH argument
 
+    // TXE interrupt feeds the transfer queue; enabled per transfer by OLED_TxStart()
+    SPI_ITConfig(SPI_IT_TXE, DISABLE);
+    NVIC_SetPriority(SPI_IRQn, 3); // Lowest: display traffic yields to everything else
+    NVIC_EnableIRQ(SPI_IRQn);
+
     // 4. Hardware Reset Sequence
     OLED_RES_LOW();
     //FirmwareDelay(10000); // Delay ~1ms
@@ -189,7 +514,19 @@ bool OLED_Init(void)
     if (!OLED_WriteCommand(0xA6)) return false; // Set Normal Display
 
     // Clear screen RAM, check status
+#ifdef OLED_USE_BUFFER
+    {
+        // Panel RAM is undefined after reset: push every page once, whatever the buffer holds
+        uint8_t page;
+        OLED_Clear();
+        for (page = 0; page < OLED_PAGES; page++) {
+            OLED_MarkDirty(page, 0, OLED_WIDTH - 1);
+        }
+    }
+    if (!OLED_UpdateScreen()) {
+#else
     if (!OLED_Clear()) {
+#endif
         // Error already handled by ErrorHandler_Handle in OLED_Clear->OLED_WriteData->SPI_WriteByte
         // We still need to report the overall OLED init failure though.
         ErrorHandler_Handle(ERROR_OLED_INIT_FAILED, "OLED_Init_Clear", __LINE__);
@@ -229,18 +566,13 @@ bool OLED_SetCursor(uint8_t x, uint8_t y)
  */
 bool OLED_Clear(void)
 {
-    uint8_t i, n;
-    for(i = 0; i < 8; i++)
+    uint8_t zero = 0x00;
+    uint8_t i;
+    for(i = 0; i < OLED_PAGES; i++)
     {
-        // OLED_SetCursor calls OLED_WriteCommand which now returns bool, but we might ignore its status here
-        // as failure is more likely during the bulk data write. Or check it too for robustness.
-        OLED_SetCursor(0, i); // Assuming SetCursor failure is less critical or handled internally if needed
-        for(n = 0; n < 128; n++)
-        {
-            if (!OLED_WriteData(0x00)) {
-                // Error already handled by ErrorHandler_Handle in OLED_WriteData->SPI_WriteByte
-                return false; // Propagate failure
-            }
+        if (!OLED_DrawPageRun(0, i, &zero, OLED_WIDTH, true)) {
+            // Error already handled by ErrorHandler_Handle in SPI_WriteBurst
+            return false; // Propagate failure
         }
     }
     return true; // Success
@@ -252,14 +584,10 @@ bool OLED_Clear(void)
  */
 void OLED_Fill(uint8_t data)
 {
-    uint8_t i, n;
-    for(i = 0; i < 8; i++)
+    uint8_t i;
+    for(i = 0; i < OLED_PAGES; i++)
     {
-        OLED_SetCursor(0, i);
-        for(n = 0; n < 128; n++)
-        {
-            OLED_WriteData(data);
-        }
+        OLED_DrawPageRun(0, i, &data, OLED_WIDTH, true);
     }
 }
 
@@ -277,28 +605,19 @@ void OLED_Fill(uint8_t data)
  */
 bool OLED_ShowChar(uint8_t x, uint8_t y, char chr, uint8_t size)
 {
-    uint8_t c = 0, i = 0;
+    uint8_t c = 0;
     c = chr - ' '; // Get character index in font table (assuming ASCII starts from space)
 
     if (x > OLED_WIDTH - 1) { x = 0; y++; } // Basic wrap-around
 
     if (size == 8) // 8x16 Font
     {
-        if (!OLED_SetCursor(x, y)) return false;
-        for (i = 0; i < 8; i++) {
-            if (!OLED_WriteData(F8X16[c * 16 + i])) return false; // Write top half
-        }
-        if (!OLED_SetCursor(x, y + 1)) return false;
-        for (i = 0; i < 8; i++) {
-            if (!OLED_WriteData(F8X16[c * 16 + i + 8])) return false; // Write bottom half
-        }
+        if (!OLED_DrawPageRun(x, y, &F8X16[c * 16], 8, false)) return false;         // Top half
+        if (!OLED_DrawPageRun(x, y + 1, &F8X16[c * 16 + 8], 8, false)) return false; // Bottom half
     }
     else // Default to 6x8 Font
     {
-        if (!OLED_SetCursor(x, y)) return false;
-        for (i = 0; i < 6; i++) {
-            if (!OLED_WriteData(F6x8[c][i])) return false;
-        }
+        if (!OLED_DrawPageRun(x, y, F6x8[c], 6, false)) return false;
     }
     return true;
 }
@@ -418,41 +737,47 @@ void OLED_DrawBMP(uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1, const uint8_t
     // Typically involves setting the drawing window and streaming pixel data.
     // Example for a simple monochrome format matching OLED pages:
     uint16_t i = 0;
-    uint8_t x, y;
-    // uint8_t width = x1 - x0 + 1; // Unused variable removed
+    uint8_t y;
+    uint8_t width = x1 - x0 + 1;
     uint8_t height_pages = (y1 - y0 + 1) / 8; // Assuming height is multiple of 8
-    bool status = true;
 
     for (y = y0 / 8; y < (y0 / 8) + height_pages; y++)
     {
-        if (!OLED_SetCursor(x0, y)) { status = false; break; } // Check cursor set status
-        for (x = x0; x <= x1; x++)
-        {
-            if (!OLED_WriteData(BMP[i++])) { status = false; break; } // Check data write status
-        }
-        if (!status) break; // Exit outer loop if inner loop failed
+        if (!OLED_DrawPageRun(x0, y, &BMP[i], width, false)) break; // Check data write status
+        i += width;
     }
     // Return status? Function is void currently. Consider changing if needed.
 }
 
-// Placeholder for buffer update function if using buffer
-void OLED_UpdateScreen(void)
+/**
+ * @brief Queues the changed parts of OLED_GRAM for the panel and returns at once:
+ *        for each dirty page, one segment with the cursor commands and its dirty
+ *        column span. Clean pages cost nothing. Bytes redrawn while a page is in
+ *        flight are marked dirty again and go out with the next update.
+ *        Without OLED_USE_BUFFER drawing goes straight to the panel and this does nothing.
+ * @return true if everything was queued, false if the queue was full (those pages stay dirty).
+ */
+bool OLED_UpdateScreen(void)
 {
     #ifdef OLED_USE_BUFFER
-    // Implementation to write OLED_GRAM buffer to the screen
-    uint8_t i, n;
-    bool status = true;
-    for(i = 0; i < 8; i++)
+    uint8_t page;
+    for (page = 0; page < OLED_PAGES; page++)
     {
-        if (!OLED_SetCursor(0, i)) { status = false; break; }
-        for(n = 0; n < 128; n++)
-        {
-            if (!OLED_WriteData(OLED_GRAM[i * 128 + n])) { status = false; break; }
+        uint8_t lo = oled_dirty_lo[page];
+        uint8_t hi = oled_dirty_hi[page];
+        uint8_t cmd[3];
+        if (hi == 0) continue; // Page unchanged
+
+        cmd[0] = 0xB0 + page;         // Set Page Start Address
+        cmd[1] = 0x00 | (lo & 0x0F);  // Set Lower Column Start Address
+        cmd[2] = 0x10 | (lo >> 4);    // Set Higher Column Start Address
+        if (!OLED_QueueTransfer(cmd, sizeof(cmd), &OLED_GRAM[page * OLED_WIDTH + lo], hi - lo)) {
+            return false; // Retried on the next update
         }
-        if (!status) break;
+        oled_dirty_hi[page] = 0;
     }
-    // Return status? Function is void currently. Consider changing if needed.
     #endif
+    return true;
 }
 
 // Placeholder for DrawPixel if using buffer
@@ -462,6 +787,7 @@ void OLED_DrawPixel(uint8_t x, uint8_t y, uint8_t color)
     if (x >= OLED_WIDTH || y >= OLED_HEIGHT) return;
     uint16_t index = (y / 8) * OLED_WIDTH + x;
     uint8_t bit_pos = y % 8;
+    uint8_t old = OLED_GRAM[index];
     if (color) // Set pixel (white)
     {
         OLED_GRAM[index] |= (1 << bit_pos);
@@ -470,17 +796,16 @@ void OLED_DrawPixel(uint8_t x, uint8_t y, uint8_t color)
     {
         OLED_GRAM[index] &= ~(1 << bit_pos);
     }
+    if (OLED_GRAM[index] != old)
+    {
+        OLED_MarkDirty(y / 8, x, x);
+    }
     #else
     // Direct drawing not implemented efficiently without buffer
     // Could read-modify-write, but that's slow over I2C
     #endif
 }
 
-#ifdef OLED_USE_BUFFER
-// Define the screen buffer if used
-uint8_t OLED_GRAM[OLED_WIDTH * OLED_HEIGHT / 8];
-#endif
-
 //--------------------------------------------------------------------------------------------------
 // Chinese Character Functions (Requires Font.h with aFontChinese16)
 //--------------------------------------------------------------------------------------------------
@@ -494,7 +819,6 @@ uint8_t OLED_GRAM[OLED_WIDTH * OLED_HEIGHT / 8];
  */
 bool OLED_ShowChineseChar(uint8_t x, uint8_t y, uint8_t index)
 {
-    uint8_t i;
     // Assuming aFontChinese16 is defined in Font.h
     extern const unsigned char aFontChinese16[][32];
     // Optional: Add bounds check for index if you know the size of aFontChinese16
@@ -506,17 +830,9 @@ bool OLED_ShowChineseChar(uint8_t x, uint8_t y, uint8_t index)
         return false; // Or handle wrap-around differently
     }
 
-    // Draw top half (16 bytes)
-    if (!OLED_SetCursor(x, y)) return false;
-    for (i = 0; i < 16; i++) {
-        if (!OLED_WriteData(aFontChinese16[index][i])) return false;
-    }
-
-    // Draw bottom half (16 bytes)
-    if (!OLED_SetCursor(x, y + 1)) return false;
-    for (i = 0; i < 16; i++) {
-        if (!OLED_WriteData(aFontChinese16[index][i + 16])) return false;
-    }
+    // Draw top half (16 bytes), then bottom half (16 bytes)
+    if (!OLED_DrawPageRun(x, y, &aFontChinese16[index][0], 16, false)) return false;
+    if (!OLED_DrawPageRun(x, y + 1, &aFontChinese16[index][16], 16, false)) return false;
 
     return true;
 }
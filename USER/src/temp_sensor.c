@@ -0,0 +1,26 @@
+#include "temp_sensor.h"
+
+/**
+ * @brief Folds the factory calibration into a Q10 centi-degree offset.
+ */
+int32_t TempSensor_CalOffset(uint8_t t0_cal, uint16_t trim_cal)
+{
+    return ((int32_t)t0_cal * 50L << TEMP_Q10_SHIFT) - (int32_t)trim_cal * TEMP_SLOPE_CC_Q10;
+}
+
+/**
+ * @brief Converts a raw sensor result (1.5V reference) to centi-degrees.
+ */
+int16_t TempSensor_RawToCentiC(int32_t offset_cc_q10, uint16_t raw)
+{
+    int32_t cc;
+
+    // Arithmetic shift floors; adding half an LSB first rounds to nearest
+    cc = (offset_cc_q10 + (int32_t)raw * TEMP_SLOPE_CC_Q10 + (1L << (TEMP_Q10_SHIFT - 1))) >> TEMP_Q10_SHIFT;
+    if (cc > INT16_MAX) {
+        cc = INT16_MAX;
+    } else if (cc < (INT16_MIN + 1)) {
+        cc = INT16_MIN + 1;
+    }
+    return (int16_t)cc;
+}
@@ -4,85 +4,29 @@
 #include "cw32f003_gpio.h"
 #include "cw32f003_uart.h"
 #include "error_handler.h" // Include the error handler
+#include "ring_buffer.h"   // SPSC ring shared with the HLW UART driver
 #include <stdio.h>
 #include <stdbool.h>
 #include <string.h> // For memcpy if needed, though likely not for single byte ops
 
-// Static ring buffer instances
+// Ring buffers: TX is filled by the main loop and drained by the TXE ISR,
+// RX is filled by the RC ISR and drained by the main loop
+static volatile uint8_t tx_storage[UART_TX_BUFFER_SIZE];
+static volatile uint8_t rx_storage[UART_RX_BUFFER_SIZE];
 static RingBuffer_t tx_buffer;
 static RingBuffer_t rx_buffer;
 
-// --- Ring Buffer Helper Functions ---
-
-/**
- * @brief Initializes a ring buffer.
- * @param rb Pointer to the RingBuffer_t structure.
- */
-static void RingBuffer_Init(RingBuffer_t *rb) {
-    rb->head = 0;
-    rb->tail = 0;
-    rb->count = 0;
-    // No need to clear rb->buffer explicitly unless required
-}
-
-/**
- * @brief Checks if the ring buffer is full.
- * @param rb Pointer to the RingBuffer_t structure.
- * @return true if full, false otherwise.
- */
-static bool RingBuffer_IsFull(const RingBuffer_t *rb) {
-    return rb->count >= UART_RX_BUFFER_SIZE; // Use RX size as it's the same or larger
-}
-
 /**
- * @brief Checks if the ring buffer is empty.
- * @param rb Pointer to the RingBuffer_t structure.
- * @return true if empty, false otherwise.
+ * @brief Enables the TXE interrupt so the ISR starts draining the TX buffer.
  */
-static bool RingBuffer_IsEmpty(const RingBuffer_t *rb) {
-    return rb->count == 0;
-}
-
-/**
- * @brief Adds a byte to the ring buffer.
- * @param rb Pointer to the RingBuffer_t structure.
- * @param data The byte to add.
- * @return true if successful, false if buffer is full.
- */
-static bool RingBuffer_Put(RingBuffer_t *rb, uint8_t data) {
-    if (RingBuffer_IsFull(rb)) {
-        return false; // Buffer full
-    }
-    rb->buffer[rb->head] = data;
-		//环绕效果，到达SIZE后head = 0
-    rb->head = (rb->head + 1) % UART_RX_BUFFER_SIZE; // Use RX size
-    __disable_irq(); // Enter critical section
-    rb->count++;
-    __enable_irq();  // Exit critical section
-    return true;
-}
-
-/**
- * @brief Retrieves a byte from the ring buffer.
- * @param rb Pointer to the RingBuffer_t structure.
- * @param data Pointer to store the retrieved byte.
- * @return true if successful, false if buffer is empty.
- */
-static bool RingBuffer_Get(RingBuffer_t *rb, uint8_t *data) {
-    if (RingBuffer_IsEmpty(rb)) {
-        return false; // Buffer empty
+static void UART_StartTx(void) {
+    __disable_irq(); // Enter critical section (IER read-modify-write, also done by the ISR)
+    if (!(DEBUG_USART_PERIPH->IER & USART_IT_TXE)) { // Use peripheral macro
+        USART_ITConfig(DEBUG_USART_PERIPH, USART_IT_TXE, ENABLE); // Use peripheral macro
     }
-    *data = rb->buffer[rb->tail];
-    rb->tail = (rb->tail + 1) % UART_RX_BUFFER_SIZE; // Use RX size
-		//通过暂时关闭中断通道，创建一个保护区确保rb->count在自增自减时不被打断，避免错误
-    __disable_irq(); // Enter critical section
-    rb->count--;
     __enable_irq();  // Exit critical section
-    return true;
 }
 
-// --- End Ring Buffer Helper Functions ---
-
 
 
 #ifdef __GNUC__
@@ -105,8 +49,10 @@ bool UART_Driver_Init(uint32_t baudRate) // Changed return type to bool
     GPIO_InitTypeDef GPIO_InitStructure;
 
     // Initialize ring buffers
-    RingBuffer_Init(&tx_buffer);
-    RingBuffer_Init(&rx_buffer);
+    if (!RingBuffer_Init(&tx_buffer, tx_storage, UART_TX_BUFFER_SIZE) ||
+        !RingBuffer_Init(&rx_buffer, rx_storage, UART_RX_BUFFER_SIZE)) {
+        return false; // Buffer size is not a power of two
+    }
 
     // Enable peripheral clocks using macros from config.h
     // RCC_HSI_Enable(RCC_HSIOSC_DIV6); // REMOVED: System clock should be set in SystemInit, not here.
@@ -160,31 +106,49 @@ bool UART_Driver_Init(uint32_t baudRate) // Changed return type to bool
  * @return true if all data was successfully added to the buffer, false otherwise (buffer full).
  */
 bool UART_Write(const uint8_t* data, uint16_t length) {
-    uint16_t i;
-    for (i = 0; i < length; ++i) {
-        // Wait if buffer is full - this makes UART_Write blocking if buffer fills
-        // A truly non-blocking version would return false immediately.
-        while (RingBuffer_IsFull(&tx_buffer)) {
-             // Optional: Add a small delay or yield if in an RTOS
-        }
-        if (!RingBuffer_Put(&tx_buffer, data[i])) {
-             // This should ideally not happen due to the while loop above,
-             // but included for robustness.
-            return false;
-        }
+    while (length > 0) {
+        // Copy what fits, then make sure the ISR is draining before waiting for more room.
+        // This makes UART_Write blocking if the message is longer than the free space.
+        uint16_t n = RingBuffer_PutBulk(&tx_buffer, data, length);
+        data += n;
+        length -= n;
+        UART_StartTx();
     }
 
-    // If TXE interrupt is not enabled and there's data, enable it to start transmission
-    __disable_irq();
-    // Check IER register directly using the interrupt bit definition
-    if (!RingBuffer_IsEmpty(&tx_buffer) && !(DEBUG_USART_PERIPH->IER & USART_IT_TXE)) { // Use peripheral macro
-        USART_ITConfig(DEBUG_USART_PERIPH, USART_IT_TXE, ENABLE); // Use peripheral macro
+    return true;
+}
+
+
+/**
+ * @brief Writes a NUL-terminated string to the UART TX buffer.
+ *        Console output without pulling printf into the image; format numbers with fmt.h.
+ * @param str String to send.
+ * @return true if successful.
+ */
+bool UART_WriteString(const char* str) {
+    uint16_t length = 0;
+    while (str[length] != '\0') {
+        length++;
     }
-    __enable_irq();
+    return UART_Write((const uint8_t*)str, length);
+}
 
-    return true;
+/**
+ * @brief Checks whether all queued TX data has left the shift register.
+ * @return true if the TX buffer is empty and no transmission is in progress.
+ */
+bool UART_TxIdle(void) {
+    return RingBuffer_IsEmpty(&tx_buffer) &&
+           (USART_GetFlagStatus(DEBUG_USART_PERIPH, USART_FLAG_TXBUSY) == RESET);
 }
 
+/**
+ * @brief Gets the free space in the TX buffer.
+ * @return Number of bytes UART_Write() can take without waiting.
+ */
+uint16_t UART_TxSpace(void) {
+    return (uint16_t)(UART_TX_BUFFER_SIZE - RingBuffer_Count(&tx_buffer));
+}
 
 /**
  * @brief Reads a single byte from the UART RX buffer.
@@ -220,20 +184,13 @@ PUTCHAR_PROTOTYPE
     uint8_t c = (uint8_t)ch;
     // This makes printf blocking if the buffer is full.
     // A more advanced implementation might handle buffer overflow differently.
-    while (RingBuffer_IsFull(&tx_buffer)) {
+    while (!RingBuffer_Put(&tx_buffer, c)) {
         // Wait for space in the buffer
         // Optional: Add a small delay or yield if in an RTOS
     }
 
-    RingBuffer_Put(&tx_buffer, c);
-
     // Ensure TXE interrupt is enabled if it's not already
-    __disable_irq();
-    // Check IER register directly using the interrupt bit definition
-    if (!(DEBUG_USART_PERIPH->IER & USART_IT_TXE)) { // Use peripheral macro
-        USART_ITConfig(DEBUG_USART_PERIPH, USART_IT_TXE, ENABLE); // Use peripheral macro
-    }
-    __enable_irq();
+    UART_StartTx();
 
     return ch;
 }
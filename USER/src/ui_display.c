@@ -2,104 +2,242 @@
 #include "spi_oled_driver.h" // Use SPI OLED driver
 #include "charging_sm.h"     // To get current state
 #include "ac_measurement.h"  // To get current reading
+#include "adc_driver.h"      // For the internal temperature
 #include "error_handler.h"   // Include error handler
-#include <stdio.h>          // For sprintf
-#include <string.h>         // For memset
+#include "fmt.h"             // Number formatting (no printf, no float)
+#include <string.h>         // For strlen
+
+// Retained-mode screen: static labels are drawn once, and each dynamic field keeps
+// the text it last put on screen. An update formats every field and repaints only
+// the glyph cells whose character changed; the OLED buffer then sends just those.
+//
+//   page 0-1  [充电状态]      STATE      (8x16)
+//   page 2    Current       12.3 A       (6x8 from here down)
+//   page 3    Voltage        230 V
+//   page 4    Power         2829 W
+//   page 5    Energy     12.34 kWh
+//   page 6    Temp          25.3 C
+//   page 7    Error           none
+
+#define UI_FIELD_MAX_CHARS  12 // Longest field, in characters
+#define UI_VALUE_X          54 // Value column of the 6x8 rows (after a 9-character label)
+
+typedef enum {
+    UI_FIELD_STATE = 0,
+    UI_FIELD_CURRENT,
+    UI_FIELD_VOLTAGE,
+    UI_FIELD_POWER,
+    UI_FIELD_ENERGY,
+    UI_FIELD_TEMP,
+    UI_FIELD_ERROR,
+    UI_FIELD_COUNT
+} UI_FieldId_t;
+
+typedef struct {
+    uint8_t x;      // Left edge, pixels
+    uint8_t page;   // Top page
+    uint8_t size;   // Font size (6 for 6x8, 8 for 8x16), as OLED_ShowChar()
+    uint8_t width;  // Cells; text is right-aligned so digits keep their place
+} UI_Field_t;
+
+typedef struct {
+    uint8_t x;
+    uint8_t page;
+    const char *text;
+} UI_Label_t;
+
+static const UI_Field_t ui_fields[UI_FIELD_COUNT] = {
+    // x            page size width
+    { 64,           0,   8,   8  },  // UI_FIELD_STATE
+    { UI_VALUE_X,   2,   6,   12 },  // UI_FIELD_CURRENT
+    { UI_VALUE_X,   3,   6,   12 },  // UI_FIELD_VOLTAGE
+    { UI_VALUE_X,   4,   6,   12 },  // UI_FIELD_POWER
+    { UI_VALUE_X,   5,   6,   12 },  // UI_FIELD_ENERGY
+    { UI_VALUE_X,   6,   6,   12 },  // UI_FIELD_TEMP
+    { UI_VALUE_X,   7,   6,   12 },  // UI_FIELD_ERROR
+};
+
+static const UI_Label_t ui_labels[] = {
+    { 0, 2, "Current" },
+    { 0, 3, "Voltage" },
+    { 0, 4, "Power" },
+    { 0, 5, "Energy" },
+    { 0, 6, "Temp" },
+    { 0, 7, "Error" },
+};
+
+// Chinese header "充电状态". Indices: 0="充", 1="电", 2="枪", 3="状", 4="态"
+static const uint8_t ui_header_indices[] = {0, 1, 3, 4};
+
+static char ui_shown[UI_FIELD_COUNT][UI_FIELD_MAX_CHARS]; // Cells on screen per field
+static bool ui_labels_drawn = false;
+static volatile bool ui_update_requested = false; // Set by UI_RequestUpdate()
+
+/**
+ * @brief Forgets what is on screen: the next update redraws labels and every field cell.
+ */
+static void UI_Invalidate(void)
+{
+    memset(ui_shown, 0, sizeof(ui_shown)); // Never equal to a printable character
+    ui_labels_drawn = false;
+}
+
+/**
+ * @brief Draws the static part of the screen.
+ */
+static void UI_DrawLabels(void)
+{
+    uint8_t i;
+
+    OLED_ShowChineseString(0, 0, ui_header_indices, sizeof(ui_header_indices));
+    for (i = 0; i < sizeof(ui_labels) / sizeof(ui_labels[0]); i++) {
+        OLED_ShowString(ui_labels[i].x, ui_labels[i].page, (char *)ui_labels[i].text, 6);
+    }
+}
+
+/**
+ * @brief Shows a value in a field, repainting only the cells that changed.
+ * @param id Field to update.
+ * @param text New value; right-aligned in the field, truncated if longer.
+ */
+static void UI_SetField(UI_FieldId_t id, const char *text)
+{
+    const UI_Field_t *field = &ui_fields[id];
+    uint8_t char_width = (field->size == 8) ? 8 : 6;
+    uint8_t len = (uint8_t)strlen(text);
+    uint8_t pad, i;
+
+    if (len > field->width) {
+        len = field->width;
+    }
+    pad = field->width - len;
+
+    for (i = 0; i < field->width; i++) {
+        char c = (i < pad) ? ' ' : text[i - pad];
+        if (ui_shown[id][i] != c) {
+            OLED_ShowChar(field->x + i * char_width, field->page, c, field->size);
+            ui_shown[id][i] = c;
+        }
+    }
+}
+
+/**
+ * @brief Gets the state field text.
+ */
+static const char *UI_StateText(SM_State_t state)
+{
+    switch (state)
+    {
+        case SM_STATE_INIT:         return "INIT";
+        case SM_STATE_IDLE:         return "IDLE (A)";
+        case SM_STATE_CONNECTED:    return "CONN (B)";
+        case SM_STATE_CHARGING_REQ: return "REQ (C)";
+        case SM_STATE_CHARGING:     return "CHRG (C)";
+        case SM_STATE_VENTILATION:  return "VENT (D)";
+        case SM_STATE_FAULT:        return "FAULT!";
+        default:                    return "UNKNOWN";
+    }
+}
 
 // --- Initialization ---
 
 /**
  * @brief Initializes the UI display.
- *        (Currently does nothing extra beyond OLED_Init called elsewhere)
+ *        The screen itself is drawn by the first UI_UpdateDisplay(), so this may run
+ *        before or after OLED_Init().
  */
 void UI_Display_Init(void)
 {
     // SPI_OLED_Init() is assumed to be called in System_Init
-    // Add any specific UI initialization here if needed
     OLED_Clear(); // Start with a clear screen using SPI driver
+    UI_Invalidate();
 }
 
 // --- Display Update ---
 
+/**
+ * @brief Marks the screen out of date. Cheap and non-blocking (callable from the
+ *        state machine); the display task redraws once the panel is free.
+ */
+void UI_RequestUpdate(void)
+{
+    ui_update_requested = true;
+}
+
+/**
+ * @brief Checks whether UI_UpdateDisplay() should run now.
+ * @return true if an update was requested and no transfer to the panel is in progress.
+ *         Requests made while busy are coalesced into one redraw of the latest state.
+ */
+bool UI_UpdatePending(void)
+{
+    return ui_update_requested && !OLED_IsBusy();
+}
+
 /**
  * @brief Updates the OLED screen based on the current charging state and data.
  */
 void UI_UpdateDisplay(void)
 {
     ErrorCode_t current_error = ErrorHandler_GetLast();
+    bool data_valid = AC_IsDataValid();
+    int16_t temp_cc = ADC_Temperature_Get_cC();
+    char buf[UI_FIELD_MAX_CHARS + 1];
+    uint8_t n;
 
-    // Clear the screen at the beginning of each update
-    OLED_Clear(); // Assuming this returns bool, handle if needed
+    ui_update_requested = false; // Drawing the current state now
 
-    if (current_error != ERROR_NONE) {
-        // --- Display Error Information ---
-        char error_msg[20];
-        // Display generic fault message or map code to specific text
-        sprintf(error_msg, "FAULT: Code %d", (int)current_error);
+    if (!ui_labels_drawn) {
+        UI_DrawLabels();
+        ui_labels_drawn = true;
+    }
 
-        // Display the error message (e.g., using 8x16 font for visibility)
-        OLED_ShowString(0, 0, "----------------", 8); // Example separator
-        OLED_ShowString(0, 2, error_msg, 8);          // Display error code on line 3 (pages 2,3)
-        OLED_ShowString(0, 4, "----------------", 8); // Example separator
+    UI_SetField(UI_FIELD_STATE, UI_StateText(SM_GetCurrentState()));
+
+    if (data_valid) {
+        uint32_t current_da = (AC_GetCurrent_mA() + 50) / 100; // Round to 0.1 A
+        uint32_t voltage_v = (AC_GetVoltage_mV() + 500) / 1000;
+        uint32_t power_w = (AC_GetPower_mW() + 500) / 1000;
+
+        n = Fmt_Fixed(buf, (int32_t)current_da, 1); // Current with 1 decimal place
+        Fmt_Str(buf + n, " A");
+        UI_SetField(UI_FIELD_CURRENT, buf);
+        n = Fmt_U32(buf, voltage_v);
+        Fmt_Str(buf + n, " V");
+        UI_SetField(UI_FIELD_VOLTAGE, buf);
+        n = Fmt_U32(buf, power_w);
+        Fmt_Str(buf + n, " W");
+        UI_SetField(UI_FIELD_POWER, buf);
+    } else {
+        // HLW8032 data stale
+        UI_SetField(UI_FIELD_CURRENT, "--.- A");
+        UI_SetField(UI_FIELD_VOLTAGE, "--- V");
+        UI_SetField(UI_FIELD_POWER, "--- W");
+    }
 
-        // Optionally display specific Chinese error text if available and mapped
-        // const uint8_t fault_indices[] = { /* indices for "故障" */ };
-        // OLED_ShowChineseString(0, 0, fault_indices, sizeof(fault_indices));
+    n = Fmt_Fixed(buf, (int32_t)(AC_Energy_GetSession_Wh() / 10), 2); // Session energy, 10 Wh resolution
+    Fmt_Str(buf + n, " kWh");
+    UI_SetField(UI_FIELD_ENERGY, buf);
 
+    if (temp_cc == ADC_TEMPERATURE_INVALID) {
+        UI_SetField(UI_FIELD_TEMP, "--.- C");
     } else {
-        // --- Display Normal Status Information ---
-
-        // Display Chinese Status (e.g., "充电状态")
-        // Indices: 0="充", 1="电", 2="枪", 3="状", 4="态"
-        // NOTE: Index 5 is out of bounds for the current aFontChinese16 array! Correcting.
-        const uint8_t status_indices[] = {0, 1, 3, 4}; // 充, 电, 状, 态
-    uint8_t num_chars = sizeof(status_indices) / sizeof(status_indices[0]);//数组元素个数=数组总字节数/单个元素字节数
-
-    OLED_ShowChineseString(0, 0, status_indices, num_chars);
-    // Add error checking if needed: if (!OLED_ShowChineseString(...)) { /* handle error */ }
-
-    // --- Display ASCII Status ---
-    SM_State_t current_sm_state = SM_GetCurrentState();
-    float current_amps = 0.0f;
-    char state_str[20] = "State: ";
-    char current_str[20] = "Current: ";
-    char temp_buf[10]; // Buffer for sprintf
-
-    // Get state string
-    switch (current_sm_state)
-    {
-        case SM_STATE_INIT:         strcat(state_str, "INIT"); break;//将字符串常量 "INIT" 追加到目标字符串 state_str 的末尾
-        case SM_STATE_IDLE:         strcat(state_str, "IDLE (A)"); break;
-        case SM_STATE_CONNECTED:    strcat(state_str, "CONN (B)"); break;
-        case SM_STATE_CHARGING_REQ: strcat(state_str, "REQ (C)"); break;
-        case SM_STATE_CHARGING:     strcat(state_str, "CHARGE(C)"); break;
-        case SM_STATE_VENTILATION:  strcat(state_str, "VENT (D)"); break;
-        case SM_STATE_FAULT:        strcat(state_str, "FAULT!"); break;
-        default:                    strcat(state_str, "UNKNOWN"); break;
+        int16_t temp_dc = (int16_t)((temp_cc + ((temp_cc < 0) ? -5 : 5)) / 10); // Round to 0.1 C
+        n = Fmt_Fixed(buf, temp_dc, 1);
+        Fmt_Str(buf + n, " C");
+        UI_SetField(UI_FIELD_TEMP, buf);
     }
 
-    // Get current only if charging
-    if (current_sm_state == SM_STATE_CHARGING) {
-        current_amps = AC_GetCurrent(); 
-        sprintf(temp_buf, "%.1f A", current_amps); // Format current with 1 decimal place
-        strcat(current_str, temp_buf);
+    if (current_error == ERROR_NONE) {
+        UI_SetField(UI_FIELD_ERROR, "none");
     } else {
-        strcat(current_str, "0.0 A");
+        n = Fmt_Str(buf, "Code ");
+        Fmt_I32(buf + n, (int32_t)current_error);
+        UI_SetField(UI_FIELD_ERROR, buf);
     }
 
-    // Update SPI OLED - Adjust Y coordinates for ASCII text
-    // Display ASCII state on line 3 (page 2)
-    OLED_ShowString(0,2 , state_str, 8); // Use SPI function, moved to y=2
-    // Display ASCII current on line 4 (page 3)
-    OLED_ShowString(0,4 , current_str, 8); // Use SPI function, moved to y=3
-
-
-    // Add other info (Voltage, Temperature from main.c?) to other lines if desired
-    // Example: Keep Voltage/Temp from main.c on lines 3 & 4
-
-    // Update the physical screen from the buffer if enabled
-    #ifdef SPI_OLED_USE_BUFFER // Check SPI buffer define if used
-    // SPI_OLED_UpdateScreen(); // Or OLED_UpdateScreen() depending on definition
-    #endif
-    } // End of else block (normal display)
+    // Queue the changed parts of the frame for the panel (one segment per changed page)
+    if (!OLED_UpdateScreen()) {
+        ui_update_requested = true; // Queue full: the rest goes out on the next run
+    }
 }
@@ -0,0 +1,137 @@
+#!/usr/bin/env python3
+"""Decoder for the firmware's tokenized log stream (USER/src/log.c).
+
+The format table is read from USER/inc/log_catalog.h, the same X-macro list the
+firmware is compiled from, so IDs always match the build they come from.
+
+Wire format per record: 0xA5, message ID, tick bits 0..15 (LE), then 4 bytes (LE)
+per argument as given by the catalogue. Bytes outside records are plain text
+(start-up messages) and are passed through.
+
+Usage:
+    stty -F /dev/ttyUSB0 9600 raw -echo
+    tools/log_decode.py /dev/ttyUSB0
+    tools/log_decode.py capture.bin
+    tools/log_decode.py --table          # print the format table
+"""
+
+import argparse
+import os
+import re
+import sys
+
+SYNC = 0xA5
+HEADER_LEN = 4
+
+ROW_RE = re.compile(r'X\(\s*(\w+)\s*,\s*(\w+)\s*,\s*(\d+)\s*,\s*"((?:[^"\\]|\\.)*)"\s*\)')
+LEVELS = {"LOG_LEVEL_ERROR": "E", "LOG_LEVEL_WARN": "W", "LOG_LEVEL_INFO": "I", "LOG_LEVEL_DEBUG": "D"}
+
+
+def default_catalog():
+    here = os.path.dirname(os.path.abspath(__file__))
+    return os.path.join(here, "..", "USER", "inc", "log_catalog.h")
+
+
+def load_catalog(path):
+    """Returns [(name, level letter, nargs, format)], indexed by message ID."""
+    with open(path, encoding="utf-8") as f:
+        text = f.read()
+    body = text[text.index("#define LOG_CATALOG(X)"):]
+    table = []
+    for name, level, nargs, fmt in ROW_RE.findall(body):
+        table.append((name, LEVELS.get(level, "?"), int(nargs), bytes(fmt, "utf-8").decode("unicode_escape")))
+    return table
+
+
+def format_message(fmt, args):
+    """Applies a catalogue format to raw 32-bit arguments (%d is signed, %u/%X unsigned)."""
+    values = []
+    for conv, arg in zip(re.findall(r"%[-0-9]*([duxX])", fmt), args):
+        values.append(arg - (1 << 32) if conv == "d" and arg & 0x80000000 else arg)
+    try:
+        return fmt % tuple(values)
+    except (TypeError, ValueError):
+        return "%s %r" % (fmt, args)
+
+
+class Decoder:
+    def __init__(self, table, out):
+        self.table = table
+        self.out = out
+        self.buf = bytearray()
+        self.text = bytearray()
+        self.tick_base = 0
+        self.last_tick = None
+
+    def _time_ms(self, tick16):
+        # Extend the 16-bit tick; records arrive in order, so a smaller value means a wrap
+        if self.last_tick is not None and tick16 < self.last_tick:
+            self.tick_base += 1 << 16
+        self.last_tick = tick16
+        return self.tick_base + tick16
+
+    def _flush_text(self):
+        if self.text:
+            self.out.write(self.text.decode("ascii", "replace"))
+            self.text.clear()
+
+    def finish(self):
+        self._flush_text()
+        self.out.flush()
+
+    def feed(self, data):
+        self.buf += data
+        while self.buf:
+            if self.buf[0] != SYNC:
+                self.text.append(self.buf.pop(0))
+                if self.text.endswith(b"\n"):
+                    self._flush_text()
+                continue
+            if len(self.buf) < 2:
+                return
+            msg_id = self.buf[1]
+            if msg_id >= len(self.table):
+                self.buf.pop(0)  # Not a record start (line noise); resynchronise
+                continue
+            name, level, nargs, fmt = self.table[msg_id]
+            length = HEADER_LEN + 4 * nargs
+            if len(self.buf) < length:
+                return
+            rec = bytes(self.buf[:length])
+            del self.buf[:length]
+            self._flush_text()
+            ms = self._time_ms(rec[2] | rec[3] << 8)
+            args = [int.from_bytes(rec[HEADER_LEN + 4 * i:HEADER_LEN + 4 * i + 4], "little") for i in range(nargs)]
+            self.out.write("[%8.3f] %s %s\n" % (ms / 1000.0, level, format_message(fmt, args)))
+        self.out.flush()
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("input", nargs="?", help="serial device or capture file (default: stdin)")
+    parser.add_argument("--catalog", default=default_catalog(), help="path to log_catalog.h")
+    parser.add_argument("--table", action="store_true", help="print the format table and exit")
+    opts = parser.parse_args()
+
+    table = load_catalog(opts.catalog)
+    if opts.table:
+        for msg_id, (name, level, nargs, fmt) in enumerate(table):
+            print("%3d %s %d %-24s %s" % (msg_id, level, nargs, name, fmt))
+        return 0
+
+    decoder = Decoder(table, sys.stdout)
+    stream = open(opts.input, "rb", buffering=0) if opts.input else sys.stdin.buffer
+    try:
+        while True:
+            data = stream.read(256)
+            if not data:
+                break
+            decoder.feed(data)
+    except KeyboardInterrupt:
+        pass
+    decoder.finish()
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,119 @@
+/*
+ * Host simulation of the overcurrent protection (USER/src/overcurrent.c): trip latency
+ * from the onset of an overcurrent to Contactor_Open(), per trip path.
+ *
+ * The firmware module is compiled in unchanged; the contactor, error handler and logger
+ * are stubbed. Samples arrive every HLW_FRAME_PERIOD_MS, as HLW8032 frames do. Each case
+ * charges at the limit until the grace period is over, then steps the current and reports
+ * the trip reason and the time from the step to the tripping sample. On the target add
+ * the frame latency (up to one measurement period plus the ~55 ms frame transfer) and
+ * the relay opening time.
+ *
+ * Build and run from the repository root:
+ *     gcc -O2 -IUSER/inc -ILibraries/inc tools/ocp_latency_sim.c -o /tmp/ocp_sim && /tmp/ocp_sim
+ */
+
+#define __CW32F003_H // Device registers are not needed; config.h is used for its constants only
+
+#include <stdio.h>
+#include "../USER/src/overcurrent.c"
+
+#define SIM_MAX_MS 60000 // Give up after a minute without a trip
+
+// --- Stubs ---
+static bool contactor_opened = false;
+
+void Contactor_Open(void)
+{
+    contactor_opened = true;
+}
+
+void ErrorHandler_Handle(ErrorCode_t error, const char *module, uint32_t line)
+{
+    (void)error;
+    (void)module;
+    (void)line;
+}
+
+void Log_Write(uint8_t id, uint8_t nargs, uint32_t a, uint32_t b)
+{
+    (void)id;
+    (void)nargs;
+    (void)a;
+    (void)b;
+}
+
+static const char *TripName(OCP_Trip_t trip)
+{
+    switch (trip) {
+        case OCP_TRIP_HARD:     return "hard";
+        case OCP_TRIP_I2T:      return "I2t";
+        case OCP_TRIP_DEADLINE: return "deadline";
+        default:                return "none";
+    }
+}
+
+/**
+ * @brief Runs one case and prints the result.
+ * @param limit_amps Advertised limit.
+ * @param current_ma Current after the step.
+ * @param step_ms How long the step lasts before the current returns to the limit
+ *        (0: until a trip or SIM_MAX_MS).
+ * @param in_grace Apply the step right after arming, inside the grace period.
+ */
+static void RunCase(uint8_t limit_amps, uint32_t current_ma, uint32_t step_ms, bool in_grace)
+{
+    uint32_t t = 0;
+    uint32_t onset;
+
+    contactor_opened = false;
+    OCP_Arm(limit_amps);
+    if (!in_grace) {
+        for (; t <= OCP_GRACE_MS; t += HLW_FRAME_PERIOD_MS) {
+            OCP_Update((uint32_t)limit_amps * 1000, t);
+        }
+    }
+
+    onset = t;
+    for (; t < onset + SIM_MAX_MS && !contactor_opened; t += HLW_FRAME_PERIOD_MS) {
+        bool stepped = (step_ms == 0) || (t - onset < step_ms);
+        OCP_Update(stepped ? current_ma : (uint32_t)limit_amps * 1000, t);
+    }
+
+    printf("limit %2u A, %5.1f A %-12s %-10s: ", limit_amps, current_ma / 1000.0,
+           (step_ms != 0) ? "(transient)" : "", in_grace ? "(in grace)" : "");
+    if (contactor_opened) {
+        printf("%-8s trip %5lu ms after onset\n", TripName(OCP_GetTrip()),
+               (unsigned long)(t - HLW_FRAME_PERIOD_MS - onset));
+    } else {
+        printf("no trip\n");
+    }
+}
+
+int main(void)
+{
+    printf("Samples every %d ms; latencies exclude the HLW8032 frame delay and relay time.\n\n",
+           HLW_FRAME_PERIOD_MS);
+
+    // 32 A limit: tolerance 35.2 A, hard trip 52.8 A
+    RunCase(32, 33000, 0, false);   // Within tolerance
+    RunCase(32, 35300, 0, false);   // Marginal overshoot: deadline
+    RunCase(32, 40000, 0, false);   // I2t
+    RunCase(32, 44000, 0, false);   // I2t, 125 % of tolerance: 2 s
+    RunCase(32, 48000, 0, false);   // I2t, faster
+    RunCase(32, 53000, 0, false);   // Hard
+    RunCase(32, 53000, 0, true);    // Hard applies during grace too
+
+    // 6 A limit: tolerance 8.0 A, hard trip 12.0 A
+    RunCase(6, 9000, 300, false);   // 300 ms transient overshoot: rides through
+    RunCase(6, 9000, 0, true);      // Sustained overshoot while the EV adapts: grace, then I2t
+    RunCase(6, 12000, 0, false);    // Hard
+
+    // 16 A and 80 A limits
+    RunCase(16, 18500, 0, false);
+    RunCase(16, 24000, 0, false);
+    RunCase(80, 90000, 0, false);
+    RunCase(80, 125000, 0, false);
+    RunCase(80, 132000, 0, false);  // Hard at 132 A
+    return 0;
+}
@@ -0,0 +1,119 @@
+/*
+ * Host benchmark: the SPSC ring buffer (USER/src/ring_buffer.c) against the ring it
+ * replaced in uart_driver.c / hlw_uart_driver.c (`% SIZE` indices and a shared count
+ * updated inside __disable_irq()/__enable_irq()).
+ *
+ * Each round queues 32 bytes and takes them out again: byte by byte on the old ring,
+ * byte by byte on the new ring, then as one RingBuffer_PutBulk()/RingBuffer_GetBulk()
+ * pair. On the host the interrupt masking is only a compiler barrier and `% 64` becomes
+ * a mask, so the per-byte figures understate the M0+ saving (a CPSID/CPSIE pair and the
+ * count read-modify-write per byte).
+ *
+ * Build and run from the repository root:
+ *     gcc -O2 -IUSER/inc tools/ring_buffer_bench.c USER/src/ring_buffer.c -o /tmp/ring_bench && /tmp/ring_bench
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <time.h>
+#include "ring_buffer.h"
+
+#define BENCH_RING_SIZE 64
+#define BENCH_BLOCK     32
+#define BENCH_ROUNDS    2000000
+
+// No interrupts on the host: keep the compiler ordering of the original critical sections
+#define __disable_irq() __asm__ volatile("" ::: "memory")
+#define __enable_irq()  __asm__ volatile("" ::: "memory")
+
+// --- The previous ring, as it was in uart_driver.c ---
+typedef struct {
+    volatile uint8_t buffer[BENCH_RING_SIZE];
+    volatile uint16_t head;
+    volatile uint16_t tail;
+    volatile uint16_t count;
+} OldRing_t;
+
+static bool OldRing_Put(OldRing_t *rb, uint8_t data)
+{
+    if (rb->count >= BENCH_RING_SIZE) {
+        return false;
+    }
+    rb->buffer[rb->head] = data;
+    rb->head = (rb->head + 1) % BENCH_RING_SIZE;
+    __disable_irq(); // Enter critical section
+    rb->count++;
+    __enable_irq();  // Exit critical section
+    return true;
+}
+
+static bool OldRing_Get(OldRing_t *rb, uint8_t *data)
+{
+    if (rb->count == 0) {
+        return false;
+    }
+    *data = rb->buffer[rb->tail];
+    rb->tail = (rb->tail + 1) % BENCH_RING_SIZE;
+    __disable_irq(); // Enter critical section
+    rb->count--;
+    __enable_irq();  // Exit critical section
+    return true;
+}
+
+static double NowNs(void)
+{
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec * 1e9 + t.tv_nsec;
+}
+
+int main(void)
+{
+    static OldRing_t old_ring;
+    static volatile uint8_t storage[BENCH_RING_SIZE];
+    static RingBuffer_t new_ring;
+    uint8_t block[BENCH_BLOCK];
+    uint8_t data;
+    unsigned checksum = 0;
+    double t0, t1, t2, t3, bytes;
+    int round, i;
+
+    RingBuffer_Init(&new_ring, storage, BENCH_RING_SIZE);
+    for (i = 0; i < BENCH_BLOCK; i++) {
+        block[i] = (uint8_t)i;
+    }
+
+    t0 = NowNs();
+    for (round = 0; round < BENCH_ROUNDS; round++) {
+        for (i = 0; i < BENCH_BLOCK; i++) {
+            OldRing_Put(&old_ring, (uint8_t)i);
+        }
+        for (i = 0; i < BENCH_BLOCK; i++) {
+            OldRing_Get(&old_ring, &data);
+            checksum += data;
+        }
+    }
+    t1 = NowNs();
+    for (round = 0; round < BENCH_ROUNDS; round++) {
+        for (i = 0; i < BENCH_BLOCK; i++) {
+            RingBuffer_Put(&new_ring, (uint8_t)i);
+        }
+        for (i = 0; i < BENCH_BLOCK; i++) {
+            RingBuffer_Get(&new_ring, &data);
+            checksum += data;
+        }
+    }
+    t2 = NowNs();
+    for (round = 0; round < BENCH_ROUNDS; round++) {
+        RingBuffer_PutBulk(&new_ring, block, BENCH_BLOCK);
+        RingBuffer_GetBulk(&new_ring, block, BENCH_BLOCK);
+        checksum += block[3];
+    }
+    t3 = NowNs();
+
+    bytes = (double)BENCH_ROUNDS * BENCH_BLOCK * 2; // One put and one get per byte
+    printf("ns per byte operation: old %.2f, new %.2f, new bulk %.2f (checksum %u)\n",
+           (t1 - t0) / bytes, (t2 - t1) / bytes, (t3 - t2) / bytes, checksum);
+    return 0;
+}
@@ -0,0 +1,110 @@
+/*
+ * Host stress test for the SPSC ring buffer (USER/src/ring_buffer.c).
+ *
+ * A producer thread and a consumer thread share one 64-byte ring, standing in for the
+ * main loop and the UART ISR. The producer mixes RingBuffer_Put() and RingBuffer_PutBulk(),
+ * the consumer mixes RingBuffer_Get() and RingBuffer_GetBulk(), and every byte carries its
+ * sequence number, so a lost, duplicated or reordered byte shows up as a mismatch.
+ *
+ * The ring relies on volatile ordering only, as on the single-core M0+; run this on an
+ * x86 host (stores are not reordered with other stores there).
+ *
+ * Build and run from the repository root:
+ *     gcc -O2 -pthread -IUSER/inc tools/ring_buffer_stress.c USER/src/ring_buffer.c -o /tmp/ring_stress && /tmp/ring_stress
+ */
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdint.h>
+#include "ring_buffer.h"
+
+#define STRESS_BYTES     20000000u
+#define STRESS_RING_SIZE 64
+#define PUT_BULK_MAX     7  // Odd block sizes so blocks straddle the wrap point
+#define GET_BULK_MAX     5
+
+static volatile uint8_t ring_storage[STRESS_RING_SIZE];
+static RingBuffer_t ring;
+
+static void *Producer(void *arg)
+{
+    uint32_t seq = 0;
+    uint8_t block[PUT_BULK_MAX];
+    (void)arg;
+
+    while (seq < STRESS_BYTES) {
+        if ((seq & 3) == 0) {
+            uint16_t len = 0;
+            uint16_t added;
+            while (len < PUT_BULK_MAX && seq + len < STRESS_BYTES) {
+                block[len] = (uint8_t)(seq + len);
+                len++;
+            }
+            added = RingBuffer_PutBulk(&ring, block, len);
+            seq += added;
+            if (added == 0) {
+                sched_yield();
+            }
+        } else if (RingBuffer_Put(&ring, (uint8_t)seq)) {
+            seq++;
+        } else {
+            sched_yield();
+        }
+    }
+    return NULL;
+}
+
+static void *Consumer(void *arg)
+{
+    uint32_t seq = 0;
+    uint8_t block[GET_BULK_MAX];
+    unsigned long *mismatches = (unsigned long *)arg;
+
+    while (seq < STRESS_BYTES) {
+        if (seq & 1) {
+            uint16_t got = RingBuffer_GetBulk(&ring, block, GET_BULK_MAX);
+            uint16_t i;
+            for (i = 0; i < got; i++, seq++) {
+                if (block[i] != (uint8_t)seq) {
+                    (*mismatches)++;
+                }
+            }
+            if (got == 0) {
+                sched_yield();
+            }
+        } else if (RingBuffer_Get(&ring, block)) {
+            if (block[0] != (uint8_t)seq) {
+                (*mismatches)++;
+            }
+            seq++;
+        } else {
+            sched_yield();
+        }
+    }
+    return NULL;
+}
+
+int main(void)
+{
+    pthread_t producer, consumer;
+    unsigned long mismatches = 0;
+    int empty_at_end, bad_size_rejected;
+
+    if (!RingBuffer_Init(&ring, ring_storage, STRESS_RING_SIZE)) {
+        printf("FAIL: init\n");
+        return 1;
+    }
+    pthread_create(&producer, NULL, Producer, NULL);
+    pthread_create(&consumer, NULL, Consumer, &mismatches);
+    pthread_join(producer, NULL);
+    pthread_join(consumer, NULL);
+
+    empty_at_end = RingBuffer_IsEmpty(&ring);
+    bad_size_rejected = !RingBuffer_Init(&ring, ring_storage, 48);
+
+    printf("%u bytes through a %d-byte ring: %lu mismatches, empty at end: %s, size 48 rejected: %s\n",
+           STRESS_BYTES, STRESS_RING_SIZE, mismatches,
+           empty_at_end ? "yes" : "no", bad_size_rejected ? "yes" : "no");
+    return (mismatches == 0 && empty_at_end && bad_size_rejected) ? 0 : 1;
+}
@@ -0,0 +1,78 @@
+/*
+ * Host test of the fixed-point internal temperature conversion (USER/src/temp_sensor.c)
+ * against the float formula it replaced in ADC_Read_Internal_Temperature():
+ *     Temp = T0 * 0.5 + 0.0924 * 1.5 * (AdcValue - Trim)
+ *
+ * Every raw code 0..4095 is converted for every T0 byte 0..255 and for trim values across
+ * the whole 12-bit range (every TEST_TRIM_STEP-th code plus both ends). Results inside the
+ * int16_t range must agree within TEST_MAX_ERR_CC centi-degrees; results outside it must
+ * saturate to the right end (INT16_MIN + 1 or INT16_MAX).
+ *
+ * Build and run from the repository root:
+ *     gcc -O2 -IUSER/inc tools/temp_fixed_point_test.c USER/src/temp_sensor.c -lm -o /tmp/temp_test && /tmp/temp_test
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <math.h>
+#include "temp_sensor.h"
+
+#define TEST_TRIM_STEP   7
+#define TEST_MAX_ERR_CC  2  // Q10 slope error (< 1.5 cC at full scale) plus the rounding step
+
+static unsigned long cases = 0;
+static unsigned long saturated = 0;
+static unsigned long failures = 0;
+static double worst = 0.0;
+static unsigned worst_t0, worst_trim, worst_raw;
+
+/**
+ * @brief Checks every T0 byte and every raw code for one trim value.
+ */
+static void RunTrim(uint16_t trim)
+{
+    uint32_t t0, raw;
+
+    for (t0 = 0; t0 <= 255; t0++) {
+        int32_t offset = TempSensor_CalOffset((uint8_t)t0, trim);
+        for (raw = 0; raw <= 4095; raw++) {
+            float deg = (float)t0 * 0.5f + 0.0924f * 1.5f * ((float)raw - (float)trim);
+            double ref_cc = (double)deg * 100.0;
+            int16_t cc = TempSensor_RawToCentiC(offset, (uint16_t)raw);
+            double err;
+
+            cases++;
+            if (ref_cc > INT16_MAX || ref_cc < INT16_MIN + 1) {
+                saturated++;
+                if (cc != (ref_cc > 0 ? INT16_MAX : INT16_MIN + 1)) {
+                    failures++;
+                }
+                continue;
+            }
+            err = fabs((double)cc - ref_cc);
+            if (err > worst) {
+                worst = err;
+                worst_t0 = t0;
+                worst_trim = trim;
+                worst_raw = raw;
+            }
+            if (err > TEST_MAX_ERR_CC) {
+                failures++;
+            }
+        }
+    }
+}
+
+int main(void)
+{
+    uint32_t trim;
+
+    for (trim = 0; trim <= 4095; trim += TEST_TRIM_STEP) {
+        RunTrim((uint16_t)trim);
+    }
+    RunTrim(4095);
+
+    printf("%lu conversions (%lu saturated): worst error %.3f cC at T0 %u, trim %u, raw %u; %lu failures\n",
+           cases, saturated, worst, worst_t0, worst_trim, worst_raw, failures);
+    return (failures == 0) ? 0 : 1;
+}